@@ -0,0 +1,65 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <benchmark/benchmark.h>
+
+namespace Quantify {
+namespace Bench {
+
+// Counts the calls to the global operator new made by the benchmark process
+class AllocationCounter
+{
+public:
+    static std::uint64_t get() { return count().load(std::memory_order_relaxed); }
+    static void increment() { count().fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    static std::atomic<std::uint64_t> &count()
+    {
+        static std::atomic<std::uint64_t> allocations(0);
+        return allocations;
+    }
+};
+
+// Reports the heap allocations per iteration of the enclosing benchmark loop
+class AllocationScope
+{
+public:
+    explicit AllocationScope(benchmark::State &state) : state(state), start(AllocationCounter::get()) {}
+    ~AllocationScope()
+    {
+        state.counters["allocs/op"] = benchmark::Counter((double) (AllocationCounter::get() - start), benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State &state;
+    std::uint64_t start;
+};
+
+}
+}
@@ -0,0 +1,368 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <quantify/batchnormalizer.h>
+#include <quantify/converter.h>
+#include <quantify/filters.h>
+#include <quantify/kernels.h>
+#include <quantify/quantilesketch.h>
+#include <quantify/quantityaccumulator.h>
+#include <quantify/quantityarray.h>
+#include <quantify/quantityexpression.h>
+#include <quantify/reductions.h>
+#include <quantify/standardunits.h>
+#include <algorithm>
+#include <vector>
+#include "allocationcounter.h"
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Bench {
+
+static std::vector<double> makeValues(std::size_t count)
+{
+    std::vector<double> values(count);
+    for(std::size_t i = 0; i < count; i++)
+        values[i] = (double) (i % 1000) * 0.25;
+
+    return values;
+}
+
+static void setBatchCounters(benchmark::State &state)
+{
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * (int64_t) sizeof(double));
+}
+
+static void QuantityConvertToLoop(benchmark::State &state)
+{
+    std::vector<Quantity> input;
+    for(double value : makeValues((std::size_t) state.range(0)))
+        input.push_back(Quantity(TemperatureUnits::degreeCelsius, value));
+    std::vector<Quantity> output(input.size());
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < input.size(); i++)
+            output[i] = input[i].convertTo(TemperatureUnits::degreeFahrenheit);
+        benchmark::ClobberMemory();
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityConvertToLoop)->Arg(1024)->Arg(65536);
+
+static void ConverterBatch(benchmark::State &state)
+{
+    std::vector<double> input = makeValues((std::size_t) state.range(0));
+    std::vector<double> output(input.size());
+    Converter converter(TemperatureUnits::degreeCelsius, TemperatureUnits::degreeFahrenheit);
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+    {
+        converter.convert(input.data(), output.data(), input.size());
+        benchmark::ClobberMemory();
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(ConverterBatch)->Arg(1024)->Arg(65536)->Arg(1 << 20);
+
+static void ConverterConstruct(benchmark::State &state)
+{
+    // exact factors on both sides, the scale is divided as a Rational
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(Converter(SpeedUnits::milePerHour, SpeedUnits::knot).getScale());
+}
+BENCHMARK(ConverterConstruct);
+
+static void ConverterConstructInexact(benchmark::State &state)
+{
+    const Unit third("third", "t", Dimensions(0, 0, -1), 1.0 / 3.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(Converter(third, FrequencyUnits::rpm).getScale());
+}
+BENCHMARK(ConverterConstructInexact);
+
+static void KernelsAffine(benchmark::State &state)
+{
+    Kernels::InstructionSet previous = Kernels::getInstructionSet();
+    Kernels::InstructionSet instructionSet = (Kernels::InstructionSet) state.range(1);
+    if(instructionSet > Kernels::getSupportedInstructionSet())
+    {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+
+    Kernels::setInstructionSet(instructionSet);
+    state.SetLabel(Kernels::getInstructionSetName(instructionSet));
+
+    std::vector<double> input = makeValues((std::size_t) state.range(0));
+    std::vector<double> output(input.size());
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+    {
+        Kernels::affine(input.data(), output.data(), input.size(), 1.8, 32.0);
+        benchmark::ClobberMemory();
+    }
+    setBatchCounters(state);
+    Kernels::setInstructionSet(previous);
+}
+BENCHMARK(KernelsAffine)
+    ->ArgsProduct({{1024, 65536}, {(int64_t) Kernels::InstructionSet::Scalar, (int64_t) Kernels::InstructionSet::SSE2,
+                                   (int64_t) Kernels::InstructionSet::AVX2, (int64_t) Kernels::InstructionSet::AVX512}});
+
+static void QuantityArrayConvertTo(benchmark::State &state)
+{
+    QuantityArray meters(LengthUnits::meter, makeValues((std::size_t) state.range(0)));
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(meters.convertTo(LengthUnits::foot));
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityArrayConvertTo)->Arg(1024)->Arg(65536);
+
+static void QuantityArrayAddDifferentUnit(benchmark::State &state)
+{
+    QuantityArray meters(LengthUnits::meter, makeValues((std::size_t) state.range(0)));
+    QuantityArray feet(LengthUnits::foot, makeValues((std::size_t) state.range(0)));
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(meters + feet);
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityArrayAddDifferentUnit)->Arg(1024)->Arg(65536);
+
+static void QuantityArrayFormula(benchmark::State &state)
+{
+    QuantityArray voltages(ElectricUnits::volt, makeValues((std::size_t) state.range(0)));
+    QuantityArray currents(ElectricUnits::ampere, makeValues((std::size_t) state.range(0)));
+    QuantityArray baseline(EnergyUnits::kilowatt, makeValues((std::size_t) state.range(0)));
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(voltages * currents + baseline);
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityArrayFormula)->Arg(1024)->Arg(65536);
+
+static void QuantityArrayFormulaFused(benchmark::State &state)
+{
+    QuantityArray voltages(ElectricUnits::volt, makeValues((std::size_t) state.range(0)));
+    QuantityArray currents(ElectricUnits::ampere, makeValues((std::size_t) state.range(0)));
+    QuantityArray baseline(EnergyUnits::kilowatt, makeValues((std::size_t) state.range(0)));
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize((Expressions::of(voltages) * currents + baseline).evaluate());
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityArrayFormulaFused)->Arg(1024)->Arg(65536);
+
+static std::vector<Quantity> makeMixedLengths(std::size_t count)
+{
+    const Unit units[] = {LengthUnits::meter, LengthUnits::foot, LengthUnits::kilometer};
+
+    std::vector<Quantity> quantities;
+    for(double value : makeValues(count))
+        quantities.push_back(Quantity(units[quantities.size() % 3], value));
+
+    return quantities;
+}
+
+static void QuantitySumLoop(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeMixedLengths((std::size_t) state.range(0));
+
+    for(auto _ : state)
+    {
+        Quantity sum(LengthUnits::meter, 0.0);
+        for(const Quantity &quantity : quantities)
+            sum = sum + quantity;
+        benchmark::DoNotOptimize(sum);
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(QuantitySumLoop)->Arg(65536);
+
+static void QuantityAccumulatorAdd(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeMixedLengths((std::size_t) state.range(0));
+
+    for(auto _ : state)
+    {
+        QuantityAccumulator accumulator(LengthUnits::meter);
+        for(const Quantity &quantity : quantities)
+            accumulator.add(quantity);
+        benchmark::DoNotOptimize(accumulator.getCount());
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityAccumulatorAdd)->Arg(65536);
+
+static void QuantityAccumulatorAddBatch(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeMixedLengths((std::size_t) state.range(0));
+
+    for(auto _ : state)
+    {
+        QuantityAccumulator accumulator(LengthUnits::meter);
+        accumulator.add(quantities);
+        benchmark::DoNotOptimize(accumulator.getCount());
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityAccumulatorAddBatch)->Arg(65536);
+
+static void ReductionsSummarize(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeMixedLengths((std::size_t) state.range(0));
+
+    for(auto _ : state)
+        benchmark::DoNotOptimize(Reductions::summarize(quantities, LengthUnits::meter, (unsigned int) state.range(1)));
+    setBatchCounters(state);
+}
+BENCHMARK(ReductionsSummarize)->Args({65536, 1})->Args({65536, 4})->Args({1 << 20, 1})->Args({1 << 20, 0});
+
+static void ReductionsSummarizeArray(benchmark::State &state)
+{
+    QuantityArray feet(LengthUnits::foot, makeValues((std::size_t) state.range(0)));
+
+    for(auto _ : state)
+        benchmark::DoNotOptimize(Reductions::summarize(feet, LengthUnits::meter, (unsigned int) state.range(1)));
+    setBatchCounters(state);
+}
+BENCHMARK(ReductionsSummarizeArray)->Args({65536, 1})->Args({1 << 20, 1})->Args({1 << 20, 0});
+
+static void QuantityNormalizeLoop(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeMixedLengths((std::size_t) state.range(0));
+    std::vector<double> output(quantities.size());
+
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < quantities.size(); i++)
+            output[i] = quantities[i].convertTo(LengthUnits::meter).getValue();
+        benchmark::DoNotOptimize(output.data());
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityNormalizeLoop)->Arg(1024)->Arg(65536);
+
+static void BatchNormalizerNormalize(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeMixedLengths((std::size_t) state.range(0));
+    std::vector<double> output(quantities.size());
+
+    for(auto _ : state)
+    {
+        BatchNormalizer::normalize(quantities.data(), quantities.size(), LengthUnits::meter, output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(BatchNormalizerNormalize)->Arg(1024)->Arg(65536);
+
+static void QuantityVectorSortQuantile(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeMixedLengths((std::size_t) state.range(0));
+
+    for(auto _ : state)
+    {
+        std::vector<Quantity> sorted = quantities;
+        std::sort(sorted.begin(), sorted.end());
+        benchmark::DoNotOptimize(sorted[sorted.size() * 99 / 100]);
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityVectorSortQuantile)->Arg(65536);
+
+static void QuantileSketchAdd(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeMixedLengths((std::size_t) state.range(0));
+
+    for(auto _ : state)
+    {
+        QuantileSketch sketch(LengthUnits::meter);
+        for(const Quantity &quantity : quantities)
+            sketch.add(quantity);
+        benchmark::DoNotOptimize(sketch.quantile(0.99));
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(QuantileSketchAdd)->Arg(65536);
+
+static void QuantileSketchAddOneUnit(benchmark::State &state)
+{
+    std::vector<Quantity> quantities;
+    for(double value : makeValues((std::size_t) state.range(0)))
+        quantities.push_back(Quantity(LengthUnits::foot, value));
+
+    for(auto _ : state)
+    {
+        QuantileSketch sketch(LengthUnits::meter);
+        for(const Quantity &quantity : quantities)
+            sketch.add(quantity);
+        benchmark::DoNotOptimize(sketch.quantile(0.99));
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(QuantileSketchAddOneUnit)->Arg(65536);
+
+static void QuantityGreaterThanLoop(benchmark::State &state)
+{
+    const QuantityArray speeds(SpeedUnits::kilometerPerHour, makeValues((std::size_t) state.range(0)));
+    const Quantity threshold(SpeedUnits::meterPerSecond, 0.2);
+
+    for(auto _ : state)
+    {
+        std::vector<char> selected(speeds.size());
+        for(std::size_t i=0; i<speeds.size(); ++i)
+            selected[i] = speeds.at(i) > threshold;
+        benchmark::DoNotOptimize(selected.data());
+    }
+    setBatchCounters(state);
+}
+BENCHMARK(QuantityGreaterThanLoop)->Arg(1024)->Arg(65536);
+
+static void FiltersGreaterThan(benchmark::State &state)
+{
+    const QuantityArray speeds(SpeedUnits::kilometerPerHour, makeValues((std::size_t) state.range(0)));
+    const Quantity threshold(SpeedUnits::meterPerSecond, 0.2);
+
+    for(auto _ : state)
+        benchmark::DoNotOptimize(Filters::greaterThan(speeds, threshold));
+    setBatchCounters(state);
+}
+BENCHMARK(FiltersGreaterThan)->Arg(1024)->Arg(65536);
+
+}
+}
@@ -0,0 +1,79 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <quantify/quantityparser.h>
+#include <string>
+#include <vector>
+#include "allocationcounter.h"
+
+namespace Quantify {
+namespace Bench {
+
+static void QuantityParserParse(benchmark::State &state)
+{
+    const std::string text("36.9 °C");
+    Quantity quantity;
+    QuantityParser::parse(text, quantity);
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+    {
+        QuantityParser::parse(text.data(), text.size(), quantity);
+        benchmark::DoNotOptimize(quantity);
+    }
+}
+BENCHMARK(QuantityParserParse);
+
+static void QuantityParserParseLines(benchmark::State &state)
+{
+    const char *units[] = {" km/h", " °C", "e3 kWh", " hPa", " m/s", " V"};
+
+    std::string buffer;
+    for(int64_t i = 0; i < state.range(0); i++)
+    {
+        buffer += std::to_string(i % 997) + "." + std::to_string(i % 7) + units[i % 6];
+        buffer += '\n';
+    }
+
+    std::vector<Quantity> quantities;
+    std::vector<QuantityParser::Status> statuses;
+    quantities.reserve((std::size_t) state.range(0));
+    statuses.reserve((std::size_t) state.range(0));
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+    {
+        quantities.clear();
+        statuses.clear();
+        benchmark::DoNotOptimize(QuantityParser::parseLines(buffer.data(), buffer.size(), quantities, statuses));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t) buffer.size());
+}
+BENCHMARK(QuantityParserParseLines)->Arg(1024)->Arg(65536);
+
+}
+}
@@ -0,0 +1,323 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/normalizedquantity.h>
+#include <quantify/quantity.h>
+#include <quantify/quantityexpression.h>
+#include <quantify/standardunits.h>
+#include <algorithm>
+#include <vector>
+#include "allocationcounter.h"
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Bench {
+
+static void QuantityConvertTo(benchmark::State &state)
+{
+    Quantity meters(LengthUnits::meter, 42.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(meters.convertTo(LengthUnits::foot));
+}
+BENCHMARK(QuantityConvertTo);
+
+static void QuantityConvertToOffset(benchmark::State &state)
+{
+    Quantity celsius(TemperatureUnits::degreeCelsius, 21.5);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(celsius.convertTo(TemperatureUnits::degreeFahrenheit));
+}
+BENCHMARK(QuantityConvertToOffset);
+
+static void QuantityAddSameUnit(benchmark::State &state)
+{
+    Quantity left(LengthUnits::meter, 1.0);
+    Quantity right(LengthUnits::meter, 2.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left + right);
+}
+BENCHMARK(QuantityAddSameUnit);
+
+static void QuantityAddDifferentUnit(benchmark::State &state)
+{
+    Quantity left(LengthUnits::meter, 1.0);
+    Quantity right(LengthUnits::foot, 2.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left + right);
+}
+BENCHMARK(QuantityAddDifferentUnit);
+
+static void QuantitySubtractSameUnit(benchmark::State &state)
+{
+    Quantity left(LengthUnits::meter, 1.0);
+    Quantity right(LengthUnits::meter, 2.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left - right);
+}
+BENCHMARK(QuantitySubtractSameUnit);
+
+static void QuantitySubtractDifferentUnit(benchmark::State &state)
+{
+    Quantity left(LengthUnits::meter, 1.0);
+    Quantity right(LengthUnits::foot, 2.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left - right);
+}
+BENCHMARK(QuantitySubtractDifferentUnit);
+
+static void QuantityMultiplyBy(benchmark::State &state)
+{
+    Quantity mass(MassUnits::kilogram, 3.0);
+    Quantity length(LengthUnits::meter, 2.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(mass * length);
+}
+BENCHMARK(QuantityMultiplyBy);
+
+static void QuantityDivideBy(benchmark::State &state)
+{
+    Quantity length(LengthUnits::kilometer, 3.0);
+    Quantity time(TimeUnits::hour, 2.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(length / time);
+}
+BENCHMARK(QuantityDivideBy);
+
+static void QuantityMultiplyByValue(benchmark::State &state)
+{
+    Quantity length(LengthUnits::meter, 3.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(length * 2.0);
+}
+BENCHMARK(QuantityMultiplyByValue);
+
+static void QuantityEqualsSameUnit(benchmark::State &state)
+{
+    Quantity left(LengthUnits::meter, 1.0);
+    Quantity right(LengthUnits::meter, 1.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left == right);
+}
+BENCHMARK(QuantityEqualsSameUnit);
+
+static void QuantityEqualsDifferentUnit(benchmark::State &state)
+{
+    Quantity left(LengthUnits::foot, 1.0);
+    Quantity right(LengthUnits::meter, 0.3048);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left == right);
+}
+BENCHMARK(QuantityEqualsDifferentUnit);
+
+static void QuantityLessThan(benchmark::State &state)
+{
+    Quantity left(LengthUnits::foot, 1.0);
+    Quantity right(LengthUnits::meter, 1.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left < right);
+}
+BENCHMARK(QuantityLessThan);
+
+static void QuantityLessOrEqual(benchmark::State &state)
+{
+    Quantity left(LengthUnits::foot, 1.0);
+    Quantity right(LengthUnits::meter, 1.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left <= right);
+}
+BENCHMARK(QuantityLessOrEqual);
+
+static void QuantityFormula(benchmark::State &state)
+{
+    Quantity mass(MassUnits::kilogram, 2.0);
+    Quantity speed(SpeedUnits::kilometerPerHour, 36.0);
+    Quantity time(TimeUnits::second, 4.0);
+    Quantity force(ForceUnits::newton, 3.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize((mass * speed) / time + force);
+}
+BENCHMARK(QuantityFormula);
+
+static void QuantityFormulaFused(benchmark::State &state)
+{
+    Quantity mass(MassUnits::kilogram, 2.0);
+    Quantity speed(SpeedUnits::kilometerPerHour, 36.0);
+    Quantity time(TimeUnits::second, 4.0);
+    Quantity force(ForceUnits::newton, 3.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize((Expressions::of(mass) * speed / time + force).evaluate());
+}
+BENCHMARK(QuantityFormulaFused);
+
+static void QuantityAddIncompatibleThrow(benchmark::State &state)
+{
+    Quantity left(LengthUnits::meter, 1.0);
+    Quantity right(TimeUnits::second, 2.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+    {
+        try
+        {
+            benchmark::DoNotOptimize(left + right);
+        }
+        catch(IncompatibleUnitsException &ex)
+        {
+            benchmark::DoNotOptimize(&ex);
+        }
+    }
+}
+BENCHMARK(QuantityAddIncompatibleThrow);
+
+static void QuantityTryAddIncompatible(benchmark::State &state)
+{
+    Quantity left(LengthUnits::meter, 1.0);
+    Quantity right(TimeUnits::second, 2.0);
+    Quantity result;
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left.tryAdd(right, result));
+}
+BENCHMARK(QuantityTryAddIncompatible);
+
+static std::vector<Quantity> makeQuantities(std::size_t count)
+{
+    const Unit units[] = {LengthUnits::meter, LengthUnits::foot, LengthUnits::meter / TimeUnits::second};
+
+    std::vector<Quantity> quantities;
+    quantities.reserve(count);
+    for(std::size_t i=0; i<count; ++i)
+        quantities.push_back(Quantity(units[i % 3], (double)((i * 7919) % count)));
+
+    return quantities;
+}
+
+static void QuantityVectorCopy(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeQuantities(state.range(0));
+    for(auto _ : state)
+    {
+        std::vector<Quantity> copy = quantities;
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(Quantity));
+}
+BENCHMARK(QuantityVectorCopy)->Range(1 << 10, 1 << 16);
+
+static void QuantityVectorGrowth(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeQuantities(state.range(0));
+    for(auto _ : state)
+    {
+        std::vector<Quantity> grown;
+        for(const Quantity &quantity : quantities)
+            grown.push_back(quantity);
+        benchmark::DoNotOptimize(grown.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(QuantityVectorGrowth)->Range(1 << 10, 1 << 16);
+
+static void QuantityVectorSort(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeQuantities(state.range(0));
+    std::vector<Quantity> sorted;
+    for(auto _ : state)
+    {
+        sorted = quantities;
+        std::sort(sorted.begin(), sorted.end(), [](const Quantity &left, const Quantity &right)
+        {
+            return left.getValue() < right.getValue();
+        });
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(QuantityVectorSort)->Range(1 << 10, 1 << 16);
+
+static void QuantityGreaterOrEqual(benchmark::State &state)
+{
+    Quantity left(LengthUnits::meter, 1.0);
+    Quantity right(LengthUnits::foot, 1.0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(left >= right);
+}
+BENCHMARK(QuantityGreaterOrEqual);
+
+static void QuantityVectorSortMixedUnits(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeQuantities(state.range(0));
+    std::vector<Quantity> lengths;
+    for(const Quantity &quantity : quantities)
+        lengths.push_back(Quantity(quantity.getUnit().getDimensions() == LengthUnits::meter.getDimensions() ? quantity.getUnit() : LengthUnits::inch, quantity.getValue()));
+
+    std::vector<Quantity> sorted;
+    for(auto _ : state)
+    {
+        sorted = lengths;
+        std::sort(sorted.begin(), sorted.end());
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(QuantityVectorSortMixedUnits)->Range(1 << 10, 1 << 16);
+
+static void NormalizedQuantityVectorSortMixedUnits(benchmark::State &state)
+{
+    const std::vector<Quantity> quantities = makeQuantities(state.range(0));
+    std::vector<NormalizedQuantity> lengths;
+    for(const Quantity &quantity : quantities)
+        lengths.push_back(NormalizedQuantity(quantity.getUnit().getDimensions() == LengthUnits::meter.getDimensions() ? quantity.getUnit() : LengthUnits::inch, quantity.getValue()));
+
+    std::vector<NormalizedQuantity> sorted;
+    for(auto _ : state)
+    {
+        sorted = lengths;
+        std::sort(sorted.begin(), sorted.end());
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(NormalizedQuantityVectorSortMixedUnits)->Range(1 << 10, 1 << 16);
+
+}
+}
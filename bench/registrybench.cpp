@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <quantify/standardunits.h>
+#include <quantify/unitregistry.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include "allocationcounter.h"
+
+namespace Quantify {
+namespace Bench {
+
+static void UnitRegistryFindBySymbol(benchmark::State &state)
+{
+    UnitRegistry registry;
+    registry.addStandardUnits();
+
+    Unit unit;
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(registry.findBySymbol("kWh", 3, unit));
+}
+BENCHMARK(UnitRegistryFindBySymbol);
+
+static void UnitRegistryFindByDimensions(benchmark::State &state)
+{
+    UnitRegistry registry;
+    registry.addStandardUnits();
+    const Dimensions energy = StandardUnits::EnergyUnits::joule.getDimensions();
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(registry.findByDimensions(energy));
+}
+BENCHMARK(UnitRegistryFindByDimensions);
+
+// Readers on the default registry from a growing number of threads, items per
+// second should scale with the thread count since lookups never lock
+static void UnitRegistryConcurrentLookup(benchmark::State &state)
+{
+    const UnitRegistry &registry = UnitRegistry::getDefault();
+    const char *symbols[] = {"m", "km/h", "°C", "kWh", "hPa", "ft"};
+    std::size_t i = (std::size_t) state.thread_index();
+    Unit unit;
+
+    for(auto _ : state)
+    {
+        const char *symbol = symbols[i++ % 6];
+        registry.findBySymbol(symbol, std::char_traits<char>::length(symbol), unit);
+        benchmark::DoNotOptimize(registry.findByDimensions(unit.getDimensions()));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(UnitRegistryConcurrentLookup)->ThreadRange(1, (int) std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+}
+}
@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <quantify/unit.h>
+#include <quantify/standardunits.h>
+#include <quantify/unitparser.h>
+#include "allocationcounter.h"
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Bench {
+
+static void UnitMultiplyBy(benchmark::State &state)
+{
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(MassUnits::kilogram * LengthUnits::meter);
+}
+BENCHMARK(UnitMultiplyBy);
+
+static void UnitDivideBy(benchmark::State &state)
+{
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(LengthUnits::kilometer / TimeUnits::hour);
+}
+BENCHMARK(UnitDivideBy);
+
+static void UnitPower(benchmark::State &state)
+{
+    int power = (int) state.range(0);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(LengthUnits::meter.power(power));
+}
+BENCHMARK(UnitPower)->Arg(2)->Arg(3)->Arg(-1);
+
+static void UnitEquals(benchmark::State &state)
+{
+    Unit squareMeter = LengthUnits::meter * LengthUnits::meter;
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(squareMeter == AreaUnits::meter2);
+}
+BENCHMARK(UnitEquals);
+
+static void UnitCopy(benchmark::State &state)
+{
+    Unit newton = (MassUnits::kilogram * LengthUnits::meter) / TimeUnits::second.power(2);
+    AllocationScope allocations(state);
+    for(auto _ : state)
+    {
+        Unit copy(newton);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(UnitCopy);
+
+static void StandardUnitsAccess(benchmark::State &state)
+{
+    AllocationScope allocations(state);
+    for(auto _ : state)
+    {
+        Unit unit = LengthUnits::mile;
+        benchmark::DoNotOptimize(unit);
+        benchmark::DoNotOptimize(unit.getFactor());
+    }
+}
+BENCHMARK(StandardUnitsAccess);
+
+static void StandardUnitsSymbol(benchmark::State &state)
+{
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(SpeedUnits::kilometerPerHour.getSymbol());
+}
+BENCHMARK(StandardUnitsSymbol);
+
+static void UnitParserCached(benchmark::State &state)
+{
+    const std::string expression("kg*m^2/s^3");
+    UnitParser::parse(expression);
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(UnitParser::parse(expression));
+}
+BENCHMARK(UnitParserCached);
+
+static void UnitParserUncached(benchmark::State &state)
+{
+    const std::string expression("kg*m^2/s^3");
+
+    AllocationScope allocations(state);
+    for(auto _ : state)
+    {
+        UnitParser::clearCache();
+        benchmark::DoNotOptimize(UnitParser::parse(expression));
+    }
+}
+BENCHMARK(UnitParserUncached);
+
+}
+}
@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "unit.h"
+#include "unitlabel.h"
+
+namespace Quantify {
+
+// Bounded memo of unit compositions (multiplyBy, divideBy and power) keyed by
+// the operand identities and labels, shared by all threads.
+class CompositionCache
+{
+public:
+    struct Statistics
+    {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::size_t size;
+        std::size_t capacity;
+    };
+
+    static bool find(UnitLabel::Operation operation, const Unit &left, const Unit &right, int power, Unit &result);
+    static void insert(UnitLabel::Operation operation, const Unit &left, const Unit &right, int power, const Unit &result);
+
+    static Statistics getStatistics();
+    static void setCapacity(std::size_t value);
+    static void clear();
+};
+
+}
@@ -0,0 +1,64 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "quantity.h"
+#include "unit.h"
+
+namespace Quantify {
+
+// Conversion from one unit to another folded into value * scale + bias.
+// Compatibility is checked once, when the converter is built.
+class Converter
+{
+public:
+    Converter(const Unit &from, const Unit &to);
+
+    double convert(double value) const { return scale * value + bias; }
+    Quantity convert(const Quantity &quantity) const;
+    void convert(const double *input, double *output, std::size_t count) const;
+    void convert(double *values, std::size_t count) const;
+    std::vector<double> convert(const std::vector<double> &values) const;
+
+    double operator()(double value) const { return convert(value); }
+    Quantity operator()(const Quantity &quantity) const { return convert(quantity); }
+
+    bool isIdentity() const;
+
+    Unit getFrom() const;
+    Unit getTo() const;
+    double getScale() const;
+    double getBias() const;
+
+private:
+    Unit from;
+    Unit to;
+    double scale;
+    double bias;
+};
+
+}
@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "quantity.h"
+#include "unit.h"
+
+#define QUANTIFY_CONVERTER_CACHE_SLOTS 4
+
+namespace Quantify {
+
+// Scale and bias from the last few source units to a fixed target unit,
+// keyed by unit id, for streams of quantities that mostly reuse a handful of
+// units. Converting a quantity does not copy its unit.
+class ConverterCache
+{
+public:
+    ConverterCache(const Unit &to);
+
+    // quantities of other dimensions throw IncompatibleUnitsException
+    double convert(const Quantity &quantity)
+    {
+        // runs of one unit only compare against the last slot used
+        const std::uint32_t id = quantity.getUnit().getId();
+        if(ids[last] == id)
+            return scales[last] * quantity.getValue() + biases[last];
+
+        for(int slot=0; slot<QUANTIFY_CONVERTER_CACHE_SLOTS; ++slot)
+        {
+            if(ids[slot] == id)
+            {
+                last = slot;
+                return scales[slot] * quantity.getValue() + biases[slot];
+            }
+        }
+
+        return convertUncached(quantity, id);
+    }
+
+    const Unit &getTo() const { return to; }
+
+private:
+    double convertUncached(const Quantity &quantity, std::uint32_t id);
+
+    Unit to;
+    std::uint32_t ids[QUANTIFY_CONVERTER_CACHE_SLOTS];
+    double scales[QUANTIFY_CONVERTER_CACHE_SLOTS];
+    double biases[QUANTIFY_CONVERTER_CACHE_SLOTS];
+    int next;
+    int last;
+};
+
+}
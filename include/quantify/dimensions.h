@@ -24,6 +24,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <ostream>
 
 #define QUANTIFY_DIMENSIONS_COUNT 7
@@ -34,27 +37,51 @@
 #define QUANTIFY_DIMENSIONS_THERMODYNAMIC_TEMPERATURE_ID 4
 #define QUANTIFY_DIMENSIONS_AMOUNT_OF_SUBSTANCE_ID 5
 #define QUANTIFY_DIMENSIONS_LUMINOUS_INTENSITY_ID 6
+#define QUANTIFY_DIMENSIONS_HIGH_BITS 0x8080808080808080ULL
 
 namespace Quantify {
 
+// The seven exponents are packed as signed 8 bit lanes of a single 64 bit
+// word (lane 7 is always 0), so comparisons are one integer compare and
+// multiplication/division are lane-wise additions/subtractions.
 class Dimensions
 {
 public:    
-    Dimensions(char length = 0, char mass = 0, char time = 0, char electricCurrent = 0, char thermodynamicTemperature = 0, char amountOfSubstance = 0, char luminousIntensity = 0);
-    Dimensions(const Dimensions &other);
-    Dimensions(Dimensions &&other);
-    ~Dimensions() noexcept {}
-
-    Dimensions &operator=(const Dimensions &other);
-    Dimensions &operator=(Dimensions &&other);
-
-    char getLength() const;
-    char getMass() const;
-    char getTime() const;
-    char getElectricCurrent() const;
-    char getThermodynamicTemperature() const;
-    char getAmountOfSubstance() const;
-    char getLuminousIntensity() const;
+    constexpr Dimensions(char length = 0, char mass = 0, char time = 0, char electricCurrent = 0, char thermodynamicTemperature = 0, char amountOfSubstance = 0, char luminousIntensity = 0)
+        : packed(lane(length, QUANTIFY_DIMENSIONS_LENGTH_ID) | lane(mass, QUANTIFY_DIMENSIONS_MASS_ID) | lane(time, QUANTIFY_DIMENSIONS_TIME_ID)
+                 | lane(electricCurrent, QUANTIFY_DIMENSIONS_ELECTRIC_CURRENT_ID) | lane(thermodynamicTemperature, QUANTIFY_DIMENSIONS_THERMODYNAMIC_TEMPERATURE_ID)
+                 | lane(amountOfSubstance, QUANTIFY_DIMENSIONS_AMOUNT_OF_SUBSTANCE_ID) | lane(luminousIntensity, QUANTIFY_DIMENSIONS_LUMINOUS_INTENSITY_ID)) {}
+
+    static constexpr Dimensions fromPacked(std::uint64_t value) { return Dimensions(value, Packed()); }
+
+    constexpr char getLength() const { return get(QUANTIFY_DIMENSIONS_LENGTH_ID); }
+    constexpr char getMass() const { return get(QUANTIFY_DIMENSIONS_MASS_ID); }
+    constexpr char getTime() const { return get(QUANTIFY_DIMENSIONS_TIME_ID); }
+    constexpr char getElectricCurrent() const { return get(QUANTIFY_DIMENSIONS_ELECTRIC_CURRENT_ID); }
+    constexpr char getThermodynamicTemperature() const { return get(QUANTIFY_DIMENSIONS_THERMODYNAMIC_TEMPERATURE_ID); }
+    constexpr char getAmountOfSubstance() const { return get(QUANTIFY_DIMENSIONS_AMOUNT_OF_SUBSTANCE_ID); }
+    constexpr char getLuminousIntensity() const { return get(QUANTIFY_DIMENSIONS_LUMINOUS_INTENSITY_ID); }
+    constexpr char get(int id) const { return (char) (signed char) ((packed >> (8 * id)) & 0xFF); }
+    constexpr std::uint64_t getPacked() const { return packed; }
+
+    // lane-wise (SWAR) arithmetic on packed exponents, a lane overflows when
+    // the signs of the operands say it should not change sign but it does
+    static constexpr std::uint64_t addPacked(std::uint64_t a, std::uint64_t b)
+    {
+        return ((a & ~QUANTIFY_DIMENSIONS_HIGH_BITS) + (b & ~QUANTIFY_DIMENSIONS_HIGH_BITS)) ^ ((a ^ b) & QUANTIFY_DIMENSIONS_HIGH_BITS);
+    }
+    static constexpr std::uint64_t subtractPacked(std::uint64_t a, std::uint64_t b)
+    {
+        return ((a | QUANTIFY_DIMENSIONS_HIGH_BITS) - (b & ~QUANTIFY_DIMENSIONS_HIGH_BITS)) ^ ((a ^ ~b) & QUANTIFY_DIMENSIONS_HIGH_BITS);
+    }
+    static constexpr bool addOverflows(std::uint64_t a, std::uint64_t b)
+    {
+        return (~(a ^ b) & (a ^ addPacked(a, b)) & QUANTIFY_DIMENSIONS_HIGH_BITS) != 0;
+    }
+    static constexpr bool subtractOverflows(std::uint64_t a, std::uint64_t b)
+    {
+        return ((a ^ b) & (a ^ subtractPacked(a, b)) & QUANTIFY_DIMENSIONS_HIGH_BITS) != 0;
+    }
 
     void setLength(char value);
     void setMass(char value);
@@ -63,14 +90,16 @@ public:
     void setThermodynamicTemperature(char value);
     void setAmountOfSubstance(char value);
     void setLuminousIntensity(char value);
+    void set(int id, char value);
 
-    bool equals(const Dimensions &other) const;
+    constexpr bool equals(const Dimensions &other) const { return packed == other.packed; }
     Dimensions multiplyBy(const Dimensions &other) const;
     Dimensions divideBy(const Dimensions &other) const;
     Dimensions power(int power) const;
+    bool powerOverflows(int power) const;
 
-    bool operator==(const Dimensions &other) const { return equals(other); }
-    bool operator!=(const Dimensions &other) const { return !equals(other); }
+    constexpr bool operator==(const Dimensions &other) const { return equals(other); }
+    constexpr bool operator!=(const Dimensions &other) const { return !equals(other); }
     Dimensions operator*(const Dimensions &other) const { return multiplyBy(other); }
     Dimensions operator/(const Dimensions &other) const { return divideBy(other); }
     friend std::ostream& operator <<(std::ostream& outputStream, const Dimensions& dimensions)
@@ -78,7 +107,7 @@ public:
         outputStream << "[";
         for(int i=0; i<QUANTIFY_DIMENSIONS_COUNT; ++i)
         {
-            outputStream << (int)dimensions.dimensions[i];
+            outputStream << (int)dimensions.get(i);
             if (i < QUANTIFY_DIMENSIONS_COUNT - 1)
                 outputStream << ", ";
         }
@@ -88,10 +117,26 @@ public:
     }
 
 private:
-    void copyFrom(const Dimensions &other);
-    void moveFrom(Dimensions &other);
+    struct Packed {};
 
-    char dimensions[QUANTIFY_DIMENSIONS_COUNT];
+    constexpr Dimensions(std::uint64_t packed, Packed) : packed(packed) {}
+
+    static constexpr std::uint64_t lane(char value, int id) { return ((std::uint64_t) (unsigned char) value) << (8 * id); }
+
+    std::uint64_t packed;
+};
+
+}
+
+namespace std {
+
+template<>
+struct hash<Quantify::Dimensions>
+{
+    std::size_t operator()(const Quantify::Dimensions &dimensions) const
+    {
+        return std::hash<std::uint64_t>()(dimensions.getPacked());
+    }
 };
 
 }
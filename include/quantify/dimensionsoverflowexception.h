@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <exception>
+#include <sstream>
+#include <string>
+#include "lazymessage.h"
+#include "dimensions.h"
+
+namespace Quantify {
+
+class DimensionsOverflowException : public std::exception
+{
+public:
+
+    DimensionsOverflowException(const Dimensions &left, const Dimensions &right, const char *operation)
+        : left(left), right(right), operation(operation), power(0) {}
+
+    DimensionsOverflowException(const Dimensions &dimensions, int power) : left(dimensions), right(), operation("^"), power(power) {}
+
+    virtual const char *what() const throw()
+    {
+        return message.get([this]() -> std::string
+        {
+            std::stringstream ss;
+            if(power != 0)
+                ss << "Dimensions " << left << " overflow in operation \"^" << power << "\".";
+            else
+                ss << "Dimensions " << left << " and " << right << " overflow in operation \"" << operation << "\".";
+
+            return ss.str();
+        }, "Dimensions overflow.");
+    }
+
+    const Dimensions &getLeft() const { return left; }
+    const Dimensions &getRight() const { return right; }
+    const char *getOperation() const { return operation; }
+    int getPower() const { return power; }
+
+private:
+    Dimensions left;
+    Dimensions right;
+    const char *operation;
+    int power;
+    LazyMessage message;
+};
+
+}
@@ -0,0 +1,57 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "quantity.h"
+#include "quantityarray.h"
+#include "selection.h"
+
+namespace Quantify {
+
+// Predicates over a QuantityArray column. The bounds are converted to the
+// column unit once and compared to the raw values with the vectorized
+// Kernels::selectRange, so the column is never converted. Bounds of other
+// dimensions throw IncompatibleUnitsException, NaN values never match.
+class Filters
+{
+public:
+    static Selection greaterThan(const QuantityArray &column, const Quantity &threshold);
+    static Selection greaterOrEqual(const QuantityArray &column, const Quantity &threshold);
+    static Selection lessThan(const QuantityArray &column, const Quantity &threshold);
+    static Selection lessOrEqual(const QuantityArray &column, const Quantity &threshold);
+    // inclusive bounds
+    static Selection between(const QuantityArray &column, const Quantity &lower, const Quantity &upper);
+    // |row - value| <= tolerance, the tolerance is a difference so only the
+    // scale of its unit applies (1 K and 1 degree Celsius are the same)
+    static Selection equals(const QuantityArray &column, const Quantity &value, const Quantity &tolerance);
+    // same rule as Quantity::equals, in the column unit
+    static Selection equals(const QuantityArray &column, const Quantity &value);
+
+private:
+    static double toColumnUnit(const QuantityArray &column, const Quantity &quantity);
+    static Selection selectRange(const QuantityArray &column, double lower, double upper);
+};
+
+}
@@ -26,31 +26,38 @@
 
 #include <exception>
 #include <sstream>
+#include <string>
+#include "lazymessage.h"
 #include "unit.h"
 
 namespace Quantify {
 
+// Keeps copies of the units, cheap since labels are shared, and only formats
+// the message when what() is called
 class IncompatibleUnitsException : public std::exception
 {
 public:
 
-    IncompatibleUnitsException(const Unit &leftUnit, const Unit &rightUnit) : leftUnit(leftUnit), rightUnit(rightUnit)
-    {
-        std::stringstream ss;
-        ss << "Units \"" << leftUnit.getSymbol() << "\" and \"" << rightUnit.getSymbol() <<  "\" are not compatible.";
-
-        message = std::move(ss.str());
-    }
+    IncompatibleUnitsException(const Unit &leftUnit, const Unit &rightUnit) : leftUnit(leftUnit), rightUnit(rightUnit) {}
 
     virtual const char *what() const throw()
     {
-        return message.c_str();
+        return message.get([this]() -> std::string
+        {
+            std::stringstream ss;
+            ss << "Units \"" << leftUnit.getSymbol() << "\" and \"" << rightUnit.getSymbol() <<  "\" are not compatible.";
+
+            return ss.str();
+        }, "Units are not compatible.");
     }
 
-private:        
-    const Unit &leftUnit;
-    const Unit &rightUnit;
-    std::string message;
+    const Unit &getLeftUnit() const { return leftUnit; }
+    const Unit &getRightUnit() const { return rightUnit; }
+
+private:
+    Unit leftUnit;
+    Unit rightUnit;
+    LazyMessage message;
 };
 
 }
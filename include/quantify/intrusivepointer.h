@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace Quantify {
+
+// Intrusive reference to an immutable shared object, takes over the initial
+// reference of a newly allocated object. T exposes a counted flag, an atomic
+// reference count and an out of line static destroy(); objects built by a
+// constexpr constructor are not counted, so they can be constant initialized
+// and are never released.
+template<typename T>
+class IntrusivePointer
+{
+public:
+    constexpr IntrusivePointer() : object(nullptr) {}
+    constexpr IntrusivePointer(const T *object) : object(object) {}
+    IntrusivePointer(const IntrusivePointer &other) noexcept : object(other.object) { acquire(); }
+    IntrusivePointer(IntrusivePointer &&other) noexcept : object(other.object) { other.object = nullptr; }
+    ~IntrusivePointer() noexcept { release(); }
+
+    IntrusivePointer &operator=(const IntrusivePointer &other) noexcept
+    {
+        other.acquire();
+        release();
+        object = other.object;
+
+        return *this;
+    }
+
+    IntrusivePointer &operator=(IntrusivePointer &&other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            object = other.object;
+            other.object = nullptr;
+        }
+
+        return *this;
+    }
+
+    void swap(IntrusivePointer &other) noexcept { std::swap(object, other.object); }
+
+    const T *get() const { return object; }
+    const T &operator*() const { return *object; }
+    const T *operator->() const { return object; }
+    explicit operator bool() const { return object != nullptr; }
+
+private:
+    void acquire() const noexcept
+    {
+        if(object && object->counted)
+            object->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() noexcept
+    {
+        if(object && object->counted && object->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            T::destroy(object);
+    }
+
+    const T *object;
+};
+
+}
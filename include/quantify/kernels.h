@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Quantify {
+
+// Vectorized kernels over contiguous double buffers. The best instruction set
+// supported by the running CPU is selected once, at first use.
+class Kernels
+{
+public:
+    enum class InstructionSet
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    static InstructionSet getInstructionSet();
+    static InstructionSet getSupportedInstructionSet();
+    static void setInstructionSet(InstructionSet value);
+    static const char *getInstructionSetName(InstructionSet value);
+
+    // output[i] = input[i] * scale + bias; AVX2 and AVX-512 use a fused
+    // multiply-add rounded once, scalar and SSE2 round the product and the sum,
+    // so results may differ by one ulp between instruction sets. input and
+    // output may be the same buffer
+    static void affine(const double *input, double *output, std::size_t count, double scale, double bias);
+    // sets bit i % 64 of bitmap[i / 64] when lower <= values[i] <= upper, NaN
+    // is never selected; bitmap holds (count + 63) / 64 words and the unused
+    // bits of the last one are cleared
+    static void selectRange(const double *values, std::size_t count, double lower, double upper, std::uint64_t *bitmap);
+};
+
+}
@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+namespace Quantify {
+
+// Message of an exception, formatted on the first what() call. Threads reading
+// the same exception object, e.g. one rethrown from an exception_ptr, may
+// format concurrently: the first one to publish its text wins and the others
+// discard theirs. Copies start empty and format again from their own fields.
+class LazyMessage
+{
+public:
+    LazyMessage() : text(nullptr) {}
+    LazyMessage(const LazyMessage &) : text(nullptr) {}
+    ~LazyMessage() { delete text.load(std::memory_order_relaxed); }
+
+    LazyMessage &operator=(const LazyMessage &other)
+    {
+        if(this != &other)
+            delete text.exchange(nullptr, std::memory_order_relaxed);
+
+        return *this;
+    }
+
+    // format returns the message, fallback is returned if it throws
+    template<typename Format>
+    const char *get(const Format &format, const char *fallback) const throw()
+    {
+        const std::string *current = text.load(std::memory_order_acquire);
+        if(current != nullptr)
+            return current->c_str();
+
+        try
+        {
+            const std::string *formatted = new std::string(format());
+            if(!text.compare_exchange_strong(current, formatted, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                delete formatted;
+                return current->c_str();
+            }
+
+            return formatted->c_str();
+        }
+        catch(...)
+        {
+            return fallback;
+        }
+    }
+
+private:
+    mutable std::atomic<const std::string *> text;
+};
+
+}
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Quantify {
+
+// Thread-safe, bounded, least recently used cache.
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache
+{
+public:
+    explicit LruCache(std::size_t capacity = 1024) : capacity(capacity), hits(0), misses(0) {}
+
+    bool get(const Key &key, Value &value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = index.find(key);
+        if(it == index.end())
+        {
+            ++misses;
+            return false;
+        }
+
+        ++hits;
+        entries.splice(entries.begin(), entries, it->second);
+        value = it->second->second;
+
+        return true;
+    }
+
+    void put(const Key &key, const Value &value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(capacity == 0)
+            return;
+
+        auto it = index.find(key);
+        if(it != index.end())
+        {
+            it->second->second = value;
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+
+        entries.emplace_front(key, value);
+        index[key] = entries.begin();
+        evict();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        index.clear();
+        entries.clear();
+        hits = 0;
+        misses = 0;
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index.size();
+    }
+
+    std::size_t getCapacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return capacity;
+    }
+
+    std::uint64_t getHits() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return hits;
+    }
+
+    std::uint64_t getMisses() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return misses;
+    }
+
+    void setCapacity(std::size_t value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        capacity = value;
+        evict();
+    }
+
+private:
+    void evict()
+    {
+        while(index.size() > capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::list<std::pair<Key, Value>> entries;
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index;
+    std::size_t capacity;
+    std::uint64_t hits;
+    std::uint64_t misses;
+};
+
+}
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include "ordering.h"
+#include "quantity.h"
+#include "unit.h"
+
+namespace Quantify {
+
+// Quantity stored along with its value in SI base units (factor and offset
+// applied, rounded once from the exact factor when the unit has one). The
+// normalized value is computed at construction, so comparing, sorting,
+// hashing and min/max across units of the same dimensions are plain double
+// operations. Unlike Quantity, equality is exact on the normalized values,
+// which keeps it consistent with the ordering and the hash.
+class NormalizedQuantity
+{
+public:
+    NormalizedQuantity(const Quantity &quantity = Quantity());
+    NormalizedQuantity(Unit unit, double value);
+
+    static double normalize(const Unit &unit, double value);
+
+    // comparisons throw IncompatibleUnitsException for different dimensions
+    Ordering compare(const NormalizedQuantity &other) const;
+    bool equals(const NormalizedQuantity &other) const { assertCompatibility(other); return normalizedValue == other.normalizedValue; }
+    bool lessThan(const NormalizedQuantity &other) const { assertCompatibility(other); return normalizedValue < other.normalizedValue; }
+    bool greaterThan(const NormalizedQuantity &other) const { assertCompatibility(other); return normalizedValue > other.normalizedValue; }
+
+    bool operator==(const NormalizedQuantity &other) const { return equals(other); }
+    bool operator!=(const NormalizedQuantity &other) const { return !equals(other); }
+    bool operator<(const NormalizedQuantity &other) const { return lessThan(other); }
+    bool operator<=(const NormalizedQuantity &other) const { return isLessOrEqual(compare(other)); }
+    bool operator>(const NormalizedQuantity &other) const { return greaterThan(other); }
+    bool operator>=(const NormalizedQuantity &other) const { return isGreaterOrEqual(compare(other)); }
+    friend std::ostream& operator <<(std::ostream& outputStream, const NormalizedQuantity& quantity)
+    {
+        outputStream << quantity.getQuantity();
+        return outputStream;
+    }
+
+    const Quantity &getQuantity() const { return quantity; }
+    double getValue() const { return quantity.getValue(); }
+    const Unit &getUnit() const { return quantity.getUnit(); }
+    double getNormalizedValue() const { return normalizedValue; }
+
+private:
+    void assertCompatibility(const NormalizedQuantity &other) const
+    {
+        if(getUnit().getDimensions() != other.getUnit().getDimensions())
+            throwIncompatibleUnits(other);
+    }
+    [[noreturn]] void throwIncompatibleUnits(const NormalizedQuantity &other) const;
+
+    Quantity quantity;
+    double normalizedValue;
+};
+
+}
+
+namespace std {
+
+template<>
+struct hash<Quantify::NormalizedQuantity>
+{
+    std::size_t operator()(const Quantify::NormalizedQuantity &quantity) const
+    {
+        const std::size_t dimensions = std::hash<Quantify::Dimensions>()(quantity.getUnit().getDimensions());
+        return dimensions ^ (std::hash<double>()(quantity.getNormalizedValue()) + 0x9e3779b97f4a7c15ULL + (dimensions << 6) + (dimensions >> 2));
+    }
+};
+
+}
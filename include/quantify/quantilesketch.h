@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "convertercache.h"
+#include "quantity.h"
+#include "quantityarray.h"
+#include "unit.h"
+
+#define QUANTIFY_QUANTILE_SKETCH_COMPRESSION 100
+#define QUANTIFY_QUANTILE_SKETCH_BUFFER_FACTOR 5
+
+namespace Quantify {
+
+// Mergeable t-digest (merging variant, k1 scale function) of quantities of
+// one dimension. Values are kept in the SI base units of the dimension, so
+// inputs and queries may use any compatible unit and sketches built in
+// different units merge directly. Memory is bounded by the compression:
+// about compression centroids plus a buffer of
+// QUANTIFY_QUANTILE_SKETCH_BUFFER_FACTOR * compression values, sorted and
+// folded into the centroids when full. Queries fold the buffer, so even
+// const access is not thread safe.
+class QuantileSketch
+{
+public:
+    // throws std::invalid_argument unless 1 <= compression <= 1e6
+    QuantileSketch(const Unit &unit = Unit(), double compression = QUANTIFY_QUANTILE_SKETCH_COMPRESSION);
+
+    // quantities of other dimensions throw IncompatibleUnitsException, NaN
+    // and infinite values are ignored
+    void add(const Quantity &quantity)
+    {
+        buffer.push_back(converters.convert(quantity));
+        if(buffer.size() == bufferSize)
+            flush();
+    }
+    void add(const Quantity *quantities, std::size_t count);
+    void add(const std::vector<Quantity> &quantities) { add(quantities.data(), quantities.size()); }
+    void add(const QuantityArray &array);
+    void merge(const QuantileSketch &other);
+    void clear();
+
+    // q in [0, 1], NaN when the sketch is empty
+    Quantity quantile(double q) const { return quantile(q, unit); }
+    Quantity quantile(double q, const Unit &unit) const;
+
+    std::uint64_t getCount() const;
+    Quantity getMin() const;
+    Quantity getMax() const;
+    const Unit &getUnit() const { return unit; }
+    double getCompression() const { return compression; }
+    std::size_t getCentroidCount() const;
+
+    // little endian binary form, about 9 to 10 bytes per centroid
+    std::string serialize() const;
+    // throws QuantileSketchFormatException for malformed data and
+    // IncompatibleUnitsException when unit has other dimensions
+    static QuantileSketch deserialize(const std::string &data, const Unit &unit);
+
+private:
+    struct Centroid
+    {
+        double mean;
+        std::uint64_t weight;
+    };
+
+    void flush() const;
+    void compress() const;
+    double interpolate(double q) const;
+
+    Unit unit;
+    Unit canonicalUnit;
+    double compression;
+    std::size_t bufferSize;
+    ConverterCache converters;
+    mutable std::vector<Centroid> centroids;
+    mutable std::vector<Centroid> merged;
+    mutable std::vector<double> buffer;
+    mutable std::uint64_t count;
+    mutable double min;
+    mutable double max;
+};
+
+}
@@ -24,7 +24,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <ostream>
+#include "ordering.h"
 #include "unit.h"
 
 namespace Quantify {
@@ -33,16 +35,21 @@ class Quantity
 {
 public:
     Quantity(Unit unit = Unit(), double value = 0);
-    Quantity(const Quantity &other);        
-    Quantity(Quantity &&other);
+    Quantity(const Quantity &other) noexcept = default;
+    Quantity(Quantity &&other) noexcept = default;
     ~Quantity() noexcept {}
 
-    Quantity &operator=(const Quantity &other);
-    Quantity &operator=(Quantity &&other);
+    Quantity &operator=(const Quantity &other) noexcept = default;
+    Quantity &operator=(Quantity &&other) noexcept = default;
 
     Quantity convertTo(const Unit &unit) const;
+    static void convert(const Unit &from, const Unit &to, const double *input, double *output, std::size_t count);
+    static void convert(const Unit &from, const Unit &to, double *values, std::size_t count);
     int toInt() const;
     float toFloat() const;
+    // three-way comparison converting other at most once
+    Ordering compare(const Quantity &other) const;
+    Ordering compare(double value) const;
     bool equals(const Quantity &other) const;
     bool lessThan(const Quantity &other) const;
     bool greaterThan(const Quantity &other) const;
@@ -58,18 +65,25 @@ public:
     Quantity divideBy(const Quantity &other) const;
     Quantity divideBy(double value) const;
 
+    // non throwing variants, result is only assigned on OperationStatus::Ok
+    OperationStatus tryConvertTo(const Unit &unit, Quantity &result) const;
+    OperationStatus tryAdd(const Quantity &other, Quantity &result) const;
+    OperationStatus trySubtract(const Quantity &other, Quantity &result) const;
+    OperationStatus tryMultiplyBy(const Quantity &other, Quantity &result) const;
+    OperationStatus tryDivideBy(const Quantity &other, Quantity &result) const;
+
     bool operator==(const Quantity &other) const { return equals(other); }
     bool operator==(double value) const { return equals(value); }
     bool operator!=(const Quantity &other) const { return !equals(other); }
     bool operator!=(double value) const { return !equals(value); }
     bool operator<(const Quantity &other) const { return lessThan(other); }
     bool operator<(double value) const { return lessThan(value); }
-    bool operator<=(const Quantity &other) const { return lessThan(other) || equals(other); }
-    bool operator<=(double value) const { return lessThan(value) || equals(value); }
+    bool operator<=(const Quantity &other) const { return isLessOrEqual(compare(other)); }
+    bool operator<=(double value) const { return isLessOrEqual(compare(value)); }
     bool operator>(const Quantity &other) const { return greaterThan(other); }
     bool operator>(double value) const { return greaterThan(value); }
-    bool operator>=(const Quantity &other) const { return greaterThan(other) || equals(other); }                   
-    bool operator>=(double value) const { return greaterThan(value) || equals(value); }
+    bool operator>=(const Quantity &other) const { return isGreaterOrEqual(compare(other)); }
+    bool operator>=(double value) const { return isGreaterOrEqual(compare(value)); }
     friend Quantity operator+(const Quantity &left, const Quantity &right) { return left.add(right); }
     friend Quantity operator+(const Quantity &left, double right) { return left.add(right); }
     friend Quantity operator+(double left, const Quantity &right) { return right.add(left); }
@@ -92,15 +106,12 @@ public:
     }
 
     double getValue() const;
-    Unit getUnit() const;
+    const Unit &getUnit() const;
 
     void setValue(double value);
     void setUnit(const Unit &value);
 
 private:
-    void copyFrom(const Quantity &other);
-    void moveFrom(Quantity &other);
-
     double value;
     Unit unit;
 };
@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "convertercache.h"
+#include "quantity.h"
+#include "quantityarray.h"
+#include "unit.h"
+
+#define QUANTIFY_QUANTITY_ACCUMULATOR_BUFFER_SIZE 64
+
+namespace Quantify {
+
+// Streaming count, sum, mean, min, max and variance of quantities in a fixed
+// unit, in constant memory. Values are converted as they come and reduced
+// by small batches: compensated (Neumaier) sum and two-pass deviations per
+// batch, merged with Chan's update, so merging per thread accumulators is
+// associative up to rounding. Input units go through a ConverterCache, so
+// adding a quantity does not copy its unit.
+// Getters fold the pending batch, so even const access is not thread safe.
+class QuantityAccumulator
+{
+public:
+    QuantityAccumulator(const Unit &unit = Unit());
+
+    // values already in the accumulator unit
+    void add(double value)
+    {
+        pending[pendingCount++] = value;
+        if(pendingCount == QUANTIFY_QUANTITY_ACCUMULATOR_BUFFER_SIZE)
+            flush();
+    }
+    void add(const double *values, std::size_t count);
+    // quantities of other dimensions throw IncompatibleUnitsException
+    void add(const Quantity &quantity) { add(converters.convert(quantity)); }
+    void add(const Quantity *quantities, std::size_t count);
+    void add(const std::vector<Quantity> &quantities) { add(quantities.data(), quantities.size()); }
+    void add(const QuantityArray &array);
+    // other may use another compatible unit, its statistics are converted
+    void merge(const QuantityAccumulator &other);
+    void clear();
+
+    std::size_t getCount() const { return count + pendingCount; }
+    Quantity getSum() const;
+    // mean, min and max of an empty accumulator are NaN
+    Quantity getMean() const;
+    Quantity getMin() const;
+    Quantity getMax() const;
+    // population variance, in the square of the unit, so the unit cannot
+    // have an offset
+    Quantity getVariance() const;
+    Quantity getStandardDeviation() const;
+    const Unit &getUnit() const { return unit; }
+
+private:
+    // folds the pending values into the statistics, called by the getters
+    void flush() const;
+    void reduce(const double *values, std::size_t count) const;
+    void merge(std::size_t count, double sum, double compensation, double mean, double squaredDeviations, double min, double max) const;
+
+    Unit unit;
+    mutable std::size_t count;
+    mutable double sum;
+    mutable double compensation;
+    mutable double mean;
+    mutable double squaredDeviations;
+    mutable double min;
+    mutable double max;
+    mutable double pending[QUANTIFY_QUANTITY_ACCUMULATOR_BUFFER_SIZE];
+    mutable std::size_t pendingCount;
+    ConverterCache converters;
+};
+
+}
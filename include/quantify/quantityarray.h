@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+#include "quantity.h"
+#include "unit.h"
+
+namespace Quantify {
+
+// Column of values sharing a single unit. Element-wise operations do the unit
+// algebra once per call and then only touch the raw doubles.
+class QuantityArray
+{
+public:
+    QuantityArray(Unit unit = Unit(), std::vector<double> values = std::vector<double>());
+    QuantityArray(Unit unit, std::size_t size, double value = 0);
+    QuantityArray(Unit unit, const std::vector<Quantity> &quantities);
+
+    std::size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    void reserve(std::size_t capacity);
+    void clear();
+    void append(double value);
+    void append(const Quantity &quantity);
+
+    double &operator[](std::size_t index) { return values[index]; }
+    double operator[](std::size_t index) const { return values[index]; }
+    Quantity at(std::size_t index) const;
+    double *data() { return values.data(); }
+    const double *data() const { return values.data(); }
+    std::vector<double>::iterator begin() { return values.begin(); }
+    std::vector<double>::iterator end() { return values.end(); }
+    std::vector<double>::const_iterator begin() const { return values.begin(); }
+    std::vector<double>::const_iterator end() const { return values.end(); }
+
+    QuantityArray convertTo(const Unit &unit) const;
+    std::vector<Quantity> toQuantities() const;
+    QuantityArray add(const QuantityArray &other) const;
+    QuantityArray add(const Quantity &other) const;
+    QuantityArray add(double value) const;
+    QuantityArray subtract(const QuantityArray &other) const;
+    QuantityArray subtract(const Quantity &other) const;
+    QuantityArray subtract(double value) const;
+    QuantityArray multiplyBy(const QuantityArray &other) const;
+    QuantityArray multiplyBy(const Quantity &other) const;
+    QuantityArray multiplyBy(double value) const;
+    QuantityArray divideBy(const QuantityArray &other) const;
+    QuantityArray divideBy(const Quantity &other) const;
+    QuantityArray divideBy(double value) const;
+
+    friend QuantityArray operator+(const QuantityArray &left, const QuantityArray &right) { return left.add(right); }
+    friend QuantityArray operator+(const QuantityArray &left, const Quantity &right) { return left.add(right); }
+    friend QuantityArray operator+(const QuantityArray &left, double right) { return left.add(right); }
+    friend QuantityArray operator-(const QuantityArray &left, const QuantityArray &right) { return left.subtract(right); }
+    friend QuantityArray operator-(const QuantityArray &left, const Quantity &right) { return left.subtract(right); }
+    friend QuantityArray operator-(const QuantityArray &left, double right) { return left.subtract(right); }
+    friend QuantityArray operator*(const QuantityArray &left, const QuantityArray &right) { return left.multiplyBy(right); }
+    friend QuantityArray operator*(const QuantityArray &left, const Quantity &right) { return left.multiplyBy(right); }
+    friend QuantityArray operator*(const QuantityArray &left, double right) { return left.multiplyBy(right); }
+    friend QuantityArray operator*(double left, const QuantityArray &right) { return right.multiplyBy(left); }
+    friend QuantityArray operator/(const QuantityArray &left, const QuantityArray &right) { return left.divideBy(right); }
+    friend QuantityArray operator/(const QuantityArray &left, const Quantity &right) { return left.divideBy(right); }
+    friend QuantityArray operator/(const QuantityArray &left, double right) { return left.divideBy(right); }
+    friend std::ostream& operator <<(std::ostream& outputStream, const QuantityArray& array)
+    {
+        outputStream << "[";
+        for(std::size_t i=0; i<array.size(); ++i)
+        {
+            outputStream << array.values[i];
+            if (i < array.size() - 1)
+                outputStream << ", ";
+        }
+        outputStream << "] " << array.unit;
+
+        return outputStream;
+    }
+
+    const Unit &getUnit() const;
+    const std::vector<double> &getValues() const;
+
+    void setUnit(const Unit &value);
+    void setValues(std::vector<double> value);
+
+private:
+    void assertSameSize(const QuantityArray &other) const;
+
+    Unit unit;
+    std::vector<double> values;
+};
+
+}
@@ -0,0 +1,404 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "quantity.h"
+#include "quantityarray.h"
+#include "unit.h"
+
+namespace Quantify {
+namespace Expressions {
+
+// Expression templates over Quantity and QuantityArray operands. Operators on
+// an expression only record the formula, evaluation composes the result unit
+// once, folds the conversions needed by + and - into a scale and a bias, and
+// then computes every value in a single pass without intermediate objects.
+//
+//   Quantity energy = Expressions::of(mass) * speed * speed + offset;
+//   QuantityArray power = Expressions::of(voltages) * currents;
+//
+// Operands are referenced, not copied: evaluate an expression within the full
+// expression that builds it, never keep it in an auto variable.
+// Doubles are plain values in the unit of the other operand: x * 2.0 and
+// x / 2.0 scale the values, x + 1.0 and 2.0 - x offset them, 1.0 / x inverts
+// both the values and the unit.
+
+struct QuantityNode
+{
+    static constexpr bool isArray = false;
+
+    explicit QuantityNode(const Quantity &quantity) : quantity(quantity) {}
+
+    Unit prepare() const { return quantity.getUnit(); }
+    std::size_t size() const { return 1; }
+    double value(std::size_t) const { return quantity.getValue(); }
+
+    const Quantity &quantity;
+};
+
+struct ArrayNode
+{
+    static constexpr bool isArray = true;
+
+    explicit ArrayNode(const QuantityArray &array) : array(array) {}
+
+    Unit prepare() const { return array.getUnit(); }
+    std::size_t size() const { return array.size(); }
+    double value(std::size_t index) const { return array[index]; }
+
+    const QuantityArray &array;
+};
+
+template<typename Left, typename Right>
+struct BinaryNode
+{
+    static constexpr bool isArray = Left::isArray || Right::isArray;
+
+    BinaryNode(const Left &left, const Right &right) : left(left), right(right) {}
+
+    std::size_t size() const
+    {
+        if(Left::isArray && Right::isArray && left.size() != right.size())
+            throw std::length_error("QuantityArray operands must have the same size.");
+
+        return Left::isArray ? left.size() : right.size();
+    }
+
+    Left left;
+    Right right;
+};
+
+template<typename Left, typename Right>
+struct MultiplyNode : public BinaryNode<Left, Right>
+{
+    MultiplyNode(const Left &left, const Right &right) : BinaryNode<Left, Right>(left, right) {}
+
+    Unit prepare() const { return this->left.prepare() * this->right.prepare(); }
+    double value(std::size_t index) const { return this->left.value(index) * this->right.value(index); }
+};
+
+template<typename Left, typename Right>
+struct DivideNode : public BinaryNode<Left, Right>
+{
+    DivideNode(const Left &left, const Right &right) : BinaryNode<Left, Right>(left, right) {}
+
+    Unit prepare() const { return this->left.prepare() / this->right.prepare(); }
+    double value(std::size_t index) const { return this->left.value(index) / this->right.value(index); }
+};
+
+// Scale and bias converting values of the right operand of a sum to the unit
+// of the left one, like Quantity::add does
+struct SumConversion
+{
+    SumConversion(const Unit &rightUnit, const Unit &leftUnit) : identity(rightUnit == leftUnit), scale(1.0), bias(0.0)
+    {
+        if(!identity)
+        {
+            rightUnit.assertCompatibility(leftUnit);
+            scale = rightUnit.getFactor() / leftUnit.getFactor();
+            bias = (rightUnit.getOffset() - leftUnit.getOffset()) / leftUnit.getFactor();
+        }
+    }
+
+    bool identity;
+    double scale;
+    double bias;
+};
+
+// The result has the left unit. The conversion is resolved when the node is
+// built, so evaluating the same expression from several threads only reads
+// it. sign is 1 for additions and -1 for subtractions.
+template<typename Left, typename Right>
+struct SumNode : public BinaryNode<Left, Right>
+{
+    SumNode(const Left &left, const Right &right, double sign)
+        : BinaryNode<Left, Right>(left, right), sign(sign), unit(left.prepare()), conversion(right.prepare(), unit) {}
+
+    Unit prepare() const { return unit; }
+
+    double value(std::size_t index) const
+    {
+        const double rightValue = conversion.identity ? this->right.value(index) : conversion.scale * this->right.value(index) + conversion.bias;
+        return this->left.value(index) + sign * rightValue;
+    }
+
+    double sign;
+    Unit unit;
+    SumConversion conversion;
+};
+
+template<typename Operand>
+struct ScaleNode
+{
+    static constexpr bool isArray = Operand::isArray;
+
+    ScaleNode(const Operand &operand, double factor) : operand(operand), factor(factor) {}
+
+    Unit prepare() const { return operand.prepare(); }
+    std::size_t size() const { return operand.size(); }
+    double value(std::size_t index) const { return operand.value(index) * factor; }
+
+    Operand operand;
+    double factor;
+};
+
+template<typename Operand>
+struct QuotientNode
+{
+    static constexpr bool isArray = Operand::isArray;
+
+    QuotientNode(const Operand &operand, double divisor) : operand(operand), divisor(divisor) {}
+
+    Unit prepare() const { return operand.prepare(); }
+    std::size_t size() const { return operand.size(); }
+    double value(std::size_t index) const { return operand.value(index) / divisor; }
+
+    Operand operand;
+    double divisor;
+};
+
+// sign is 1 for operand + offset and -1 for offset - operand
+template<typename Operand>
+struct OffsetNode
+{
+    static constexpr bool isArray = Operand::isArray;
+
+    OffsetNode(const Operand &operand, double offset, double sign = 1.0) : operand(operand), offset(offset), sign(sign) {}
+
+    Unit prepare() const { return operand.prepare(); }
+    std::size_t size() const { return operand.size(); }
+    double value(std::size_t index) const { return sign * operand.value(index) + offset; }
+
+    Operand operand;
+    double offset;
+    double sign;
+};
+
+template<typename Operand>
+struct ReciprocalNode
+{
+    static constexpr bool isArray = Operand::isArray;
+
+    ReciprocalNode(double numerator, const Operand &operand) : numerator(numerator), operand(operand) {}
+
+    Unit prepare() const { return 1.0 / operand.prepare(); }
+    std::size_t size() const { return operand.size(); }
+    double value(std::size_t index) const { return numerator / operand.value(index); }
+
+    double numerator;
+    Operand operand;
+};
+
+template<typename Node>
+class Expression
+{
+public:
+    typedef Node NodeType;
+    typedef typename std::conditional<Node::isArray, QuantityArray, Quantity>::type Result;
+
+    explicit Expression(const Node &node) : node(node) {}
+
+    Result evaluate() const
+    {
+        return evaluate(std::integral_constant<bool, Node::isArray>());
+    }
+
+    operator Result() const
+    {
+        return evaluate();
+    }
+
+    Unit getUnit() const
+    {
+        return node.prepare();
+    }
+
+    const Node &getNode() const
+    {
+        return node;
+    }
+
+private:
+    Quantity evaluate(std::false_type) const
+    {
+        const Unit unit = node.prepare();
+        return Quantity(unit, node.value(0));
+    }
+
+    QuantityArray evaluate(std::true_type) const
+    {
+        const Unit unit = node.prepare();
+        const std::size_t size = node.size();
+
+        std::vector<double> values(size);
+        for(std::size_t i=0; i<size; ++i)
+            values[i] = node.value(i);
+
+        return QuantityArray(unit, std::move(values));
+    }
+
+    Node node;
+};
+
+inline Expression<QuantityNode> of(const Quantity &quantity)
+{
+    return Expression<QuantityNode>(QuantityNode(quantity));
+}
+
+inline Expression<ArrayNode> of(const QuantityArray &array)
+{
+    return Expression<ArrayNode>(ArrayNode(array));
+}
+
+// maps an operand type to its node, operators need at least one Expression
+template<typename T>
+struct Operand
+{
+    static constexpr bool isOperand = false;
+    static constexpr bool isExpression = false;
+};
+
+template<>
+struct Operand<Quantity>
+{
+    static constexpr bool isOperand = true;
+    static constexpr bool isExpression = false;
+    typedef QuantityNode Node;
+    static Node node(const Quantity &quantity) { return Node(quantity); }
+};
+
+template<>
+struct Operand<QuantityArray>
+{
+    static constexpr bool isOperand = true;
+    static constexpr bool isExpression = false;
+    typedef ArrayNode Node;
+    static Node node(const QuantityArray &array) { return Node(array); }
+};
+
+template<typename N>
+struct Operand<Expression<N>>
+{
+    static constexpr bool isOperand = true;
+    static constexpr bool isExpression = true;
+    typedef N Node;
+    static const Node &node(const Expression<N> &expression) { return expression.getNode(); }
+};
+
+template<typename Left, typename Right, template<typename, typename> class Result,
+         bool enabled = Operand<Left>::isOperand && Operand<Right>::isOperand
+                        && (Operand<Left>::isExpression || Operand<Right>::isExpression)>
+struct BinaryResult
+{
+};
+
+template<typename Left, typename Right, template<typename, typename> class Result>
+struct BinaryResult<Left, Right, Result, true>
+{
+    typedef Expression<Result<typename Operand<Left>::Node, typename Operand<Right>::Node>> Type;
+};
+
+template<typename Left, typename Right>
+typename BinaryResult<Left, Right, MultiplyNode>::Type operator*(const Left &left, const Right &right)
+{
+    typedef typename BinaryResult<Left, Right, MultiplyNode>::Type Type;
+    return Type(typename Type::NodeType(Operand<Left>::node(left), Operand<Right>::node(right)));
+}
+
+template<typename Left, typename Right>
+typename BinaryResult<Left, Right, DivideNode>::Type operator/(const Left &left, const Right &right)
+{
+    typedef typename BinaryResult<Left, Right, DivideNode>::Type Type;
+    return Type(typename Type::NodeType(Operand<Left>::node(left), Operand<Right>::node(right)));
+}
+
+template<typename Left, typename Right>
+typename BinaryResult<Left, Right, SumNode>::Type operator+(const Left &left, const Right &right)
+{
+    typedef typename BinaryResult<Left, Right, SumNode>::Type Type;
+    return Type(typename Type::NodeType(Operand<Left>::node(left), Operand<Right>::node(right), 1.0));
+}
+
+template<typename Left, typename Right>
+typename BinaryResult<Left, Right, SumNode>::Type operator-(const Left &left, const Right &right)
+{
+    typedef typename BinaryResult<Left, Right, SumNode>::Type Type;
+    return Type(typename Type::NodeType(Operand<Left>::node(left), Operand<Right>::node(right), -1.0));
+}
+
+template<typename N>
+Expression<ScaleNode<N>> operator*(const Expression<N> &left, double right)
+{
+    return Expression<ScaleNode<N>>(ScaleNode<N>(left.getNode(), right));
+}
+
+template<typename N>
+Expression<ScaleNode<N>> operator*(double left, const Expression<N> &right)
+{
+    return Expression<ScaleNode<N>>(ScaleNode<N>(right.getNode(), left));
+}
+
+template<typename N>
+Expression<QuotientNode<N>> operator/(const Expression<N> &left, double right)
+{
+    return Expression<QuotientNode<N>>(QuotientNode<N>(left.getNode(), right));
+}
+
+template<typename N>
+Expression<ReciprocalNode<N>> operator/(double left, const Expression<N> &right)
+{
+    return Expression<ReciprocalNode<N>>(ReciprocalNode<N>(left, right.getNode()));
+}
+
+template<typename N>
+Expression<OffsetNode<N>> operator+(const Expression<N> &left, double right)
+{
+    return Expression<OffsetNode<N>>(OffsetNode<N>(left.getNode(), right));
+}
+
+template<typename N>
+Expression<OffsetNode<N>> operator+(double left, const Expression<N> &right)
+{
+    return Expression<OffsetNode<N>>(OffsetNode<N>(right.getNode(), left));
+}
+
+template<typename N>
+Expression<OffsetNode<N>> operator-(const Expression<N> &left, double right)
+{
+    return Expression<OffsetNode<N>>(OffsetNode<N>(left.getNode(), -right));
+}
+
+template<typename N>
+Expression<OffsetNode<N>> operator-(double left, const Expression<N> &right)
+{
+    return Expression<OffsetNode<N>>(OffsetNode<N>(right.getNode(), left, -1.0));
+}
+
+}
+}
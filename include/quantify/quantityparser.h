@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "quantity.h"
+
+namespace Quantify {
+
+// Parses quantity literals such as "12.5 km/h", "36.9 °C" or "1.2e3 kWh"
+// straight from the caller's buffer. Numbers are read independently of the
+// locale and units are resolved through a per thread symbol cache in front of
+// UnitParser, so the steady state neither allocates nor throws.
+class QuantityParser
+{
+public:
+    enum class Status
+    {
+        Ok,
+        Empty,
+        InvalidNumber,
+        InvalidUnit
+    };
+
+    static Status parse(const char *text, std::size_t length, Quantity &quantity);
+    static Status parse(const std::string &text, Quantity &quantity);
+    static bool parseNumber(const char *&text, const char *end, double &value);
+
+    // One quantity and one status per line of a '\n' (or "\r\n") delimited
+    // buffer, returns the number of lines parsed successfully
+    static std::size_t parseLines(const char *buffer, std::size_t length, std::vector<Quantity> &quantities,
+                                  std::vector<Status> &statuses);
+
+    static const char *getStatusName(Status value);
+};
+
+}
@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+namespace Quantify {
+
+// Exact factor numerator / denominator * 10^exponent, always kept reduced
+// (positive denominator coprime with 10 and with the numerator, numerator
+// without trailing zeros) so equal values have equal fields. A zero
+// denominator marks a value that is not exact, which is what operations
+// return on overflow or for factors that are not short decimals, callers then
+// fall back to plain doubles.
+class Rational
+{
+public:
+    constexpr Rational() : numerator(0), denominator(0), exponent(0) {}
+    constexpr Rational(std::int64_t numerator, std::int64_t denominator = 1, int exponent = 0)
+        : Rational(Divided(), denominator < 0 ? -numerator : numerator, absolute(denominator), (numerator == 0 || denominator == 0) ? 0 : exponent, denominator == 0 ? 0 : gcd(numerator, denominator)) {}
+
+    // shortest decimal that converts back to exactly the same double, if any
+    static Rational fromDouble(double value);
+
+    constexpr bool isValid() const { return denominator != 0; }
+    constexpr std::int64_t getNumerator() const { return numerator; }
+    constexpr std::int64_t getDenominator() const { return denominator; }
+    constexpr int getExponent() const { return exponent; }
+
+    // single rounding as long as the numerator, the denominator and the
+    // scaled operand stay below 2^53
+    constexpr double toDouble() const
+    {
+        return exponent >= 0 ? ((double) numerator * pow10(exponent)) / (double) denominator
+                             : (double) numerator / ((double) denominator * pow10(-exponent));
+    }
+
+    // value * this with a single rounding where long double allows it, so
+    // 12 * 0.0254 and 1 * 0.3048 give the same double
+    double scale(double value) const;
+    Rational multiplyBy(const Rational &other) const;
+    Rational divideBy(const Rational &other) const;
+    Rational power(int power) const;
+
+    constexpr bool equals(const Rational &other) const
+    {
+        return numerator == other.numerator && denominator == other.denominator && exponent == other.exponent;
+    }
+
+    constexpr bool operator==(const Rational &other) const { return equals(other); }
+    constexpr bool operator!=(const Rational &other) const { return !equals(other); }
+    Rational operator*(const Rational &other) const { return multiplyBy(other); }
+    Rational operator/(const Rational &other) const { return divideBy(other); }
+    friend std::ostream& operator <<(std::ostream& outputStream, const Rational& rational)
+    {
+        if(!rational.isValid())
+            return outputStream << "inexact";
+
+        outputStream << rational.numerator;
+        if(rational.denominator != 1)
+            outputStream << "/" << rational.denominator;
+        if(rational.exponent != 0)
+            outputStream << "e" << rational.exponent;
+
+        return outputStream;
+    }
+
+private:
+    struct Divided {};
+    struct Stripped {};
+    struct Reduced {};
+
+    // reduction stages, so each step is computed once: common divisor
+    // removed, trailing zeros moved to the exponent, then factors 2 or 5 left
+    // in the denominator traded for a power of ten
+    constexpr Rational(Divided, std::int64_t numerator, std::int64_t denominator, int exponent, std::int64_t divisor)
+        : Rational(Stripped(), divisor == 0 ? 0 : numerator / divisor, divisor == 0 ? 0 : denominator / divisor, exponent) {}
+    constexpr Rational(Stripped, std::int64_t numerator, std::int64_t denominator, int exponent)
+        : Rational(Reduced(), stripZeros(numerator), stripZeros(denominator), exponent + countZeros(numerator) - countZeros(denominator)) {}
+    constexpr Rational(Reduced, std::int64_t numerator, std::int64_t denominator, int exponent)
+        : numerator(decimalNumerator(numerator, denominator))
+        , denominator(decimalDenominator(numerator, denominator))
+        , exponent(exponent - decimalShift(numerator, denominator)) {}
+
+    static constexpr std::int64_t absolute(std::int64_t value) { return value < 0 ? -value : value; }
+    static constexpr std::int64_t gcd(std::int64_t a, std::int64_t b) { return b == 0 ? absolute(a) : gcd(b, a % b); }
+    static constexpr std::int64_t stripZeros(std::int64_t value) { return (value != 0 && value % 10 == 0) ? stripZeros(value / 10) : value; }
+    static constexpr int countZeros(std::int64_t value) { return (value != 0 && value % 10 == 0) ? 1 + countZeros(value / 10) : 0; }
+    static constexpr bool fits(std::int64_t value, std::int64_t factor) { return absolute(value) <= std::numeric_limits<std::int64_t>::max() / factor; }
+    static constexpr bool canShiftTwo(std::int64_t numerator, std::int64_t denominator) { return denominator > 1 && denominator % 2 == 0 && fits(numerator, 5); }
+    static constexpr bool canShiftFive(std::int64_t numerator, std::int64_t denominator) { return denominator > 1 && denominator % 5 == 0 && fits(numerator, 2); }
+    static constexpr std::int64_t decimalNumerator(std::int64_t numerator, std::int64_t denominator)
+    {
+        return canShiftTwo(numerator, denominator) ? decimalNumerator(numerator * 5, denominator / 2)
+             : canShiftFive(numerator, denominator) ? decimalNumerator(numerator * 2, denominator / 5) : numerator;
+    }
+    static constexpr std::int64_t decimalDenominator(std::int64_t numerator, std::int64_t denominator)
+    {
+        return canShiftTwo(numerator, denominator) ? decimalDenominator(numerator * 5, denominator / 2)
+             : canShiftFive(numerator, denominator) ? decimalDenominator(numerator * 2, denominator / 5) : denominator;
+    }
+    static constexpr int decimalShift(std::int64_t numerator, std::int64_t denominator)
+    {
+        return canShiftTwo(numerator, denominator) ? 1 + decimalShift(numerator * 5, denominator / 2)
+             : canShiftFive(numerator, denominator) ? 1 + decimalShift(numerator * 2, denominator / 5) : 0;
+    }
+    static constexpr double pow10(int exponent) { return exponent == 0 ? 1.0 : 10.0 * pow10(exponent - 1); }
+
+    std::int64_t numerator;
+    std::int64_t denominator;
+    int exponent;
+};
+
+}
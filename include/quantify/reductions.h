@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "quantity.h"
+#include "quantityaccumulator.h"
+#include "quantityarray.h"
+#include "unit.h"
+
+#define QUANTIFY_REDUCTIONS_BLOCK_SIZE 4096
+#define QUANTIFY_REDUCTIONS_MAX_THREADS 64
+
+namespace Quantify {
+
+// Parallel reductions over quantity collections. Values are split in fixed
+// size blocks, each block is converted to the target unit and reduced in its
+// own QuantityAccumulator, and the partial results are merged in block
+// order, so results are identical whatever the number of threads.
+// Blocks are shared between the calling thread and a pool of worker threads
+// created on first use and reused by later calls. threads caps how many take
+// part, 0 uses std::thread::hardware_concurrency(); inputs of a single block
+// are reduced on the calling thread.
+class Reductions
+{
+public:
+    typedef QuantityAccumulator Summary;
+
+    static Summary summarize(const Quantity *quantities, std::size_t count, const Unit &unit, unsigned int threads = 0);
+    static Summary summarize(const std::vector<Quantity> &quantities, const Unit &unit, unsigned int threads = 0);
+    static Summary summarize(const QuantityArray &array, const Unit &unit, unsigned int threads = 0);
+
+    static Quantity sum(const std::vector<Quantity> &quantities, const Unit &unit, unsigned int threads = 0) { return summarize(quantities, unit, threads).getSum(); }
+    static Quantity sum(const QuantityArray &array, const Unit &unit, unsigned int threads = 0) { return summarize(array, unit, threads).getSum(); }
+    static Quantity mean(const std::vector<Quantity> &quantities, const Unit &unit, unsigned int threads = 0) { return summarize(quantities, unit, threads).getMean(); }
+    static Quantity mean(const QuantityArray &array, const Unit &unit, unsigned int threads = 0) { return summarize(array, unit, threads).getMean(); }
+    static Quantity min(const std::vector<Quantity> &quantities, const Unit &unit, unsigned int threads = 0) { return summarize(quantities, unit, threads).getMin(); }
+    static Quantity min(const QuantityArray &array, const Unit &unit, unsigned int threads = 0) { return summarize(array, unit, threads).getMin(); }
+    static Quantity max(const std::vector<Quantity> &quantities, const Unit &unit, unsigned int threads = 0) { return summarize(quantities, unit, threads).getMax(); }
+    static Quantity max(const QuantityArray &array, const Unit &unit, unsigned int threads = 0) { return summarize(array, unit, threads).getMax(); }
+    static Quantity variance(const std::vector<Quantity> &quantities, const Unit &unit, unsigned int threads = 0) { return summarize(quantities, unit, threads).getVariance(); }
+    static Quantity variance(const QuantityArray &array, const Unit &unit, unsigned int threads = 0) { return summarize(array, unit, threads).getVariance(); }
+
+private:
+    // adds the values [first, first + count) to the partial result of a
+    // block, buffer is scratch space of QUANTIFY_REDUCTIONS_BLOCK_SIZE values
+    // reused by every block of a worker
+    typedef std::function<void(std::size_t first, std::size_t count, double *buffer, QuantityAccumulator &partial)> BlockReducer;
+
+    static Summary reduce(std::size_t count, const Unit &unit, unsigned int threads, const BlockReducer &reducer);
+};
+
+}
@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Quantify {
+
+// Bitmap of selected rows, one bit per row packed in 64 bit words, as
+// produced by the Filters over QuantityArray columns. Selections of columns
+// of the same size combine with & (and) and | (or).
+class Selection
+{
+public:
+    Selection(std::size_t size = 0, bool selected = false);
+
+    std::size_t size() const { return length; }
+    bool isSelected(std::size_t index) const { return (words[index / 64] >> (index % 64)) & 1; }
+    bool operator[](std::size_t index) const { return isSelected(index); }
+    void setSelected(std::size_t index, bool value);
+    std::size_t count() const;
+    std::vector<std::size_t> toIndices() const;
+
+    Selection intersect(const Selection &other) const;
+    Selection unite(const Selection &other) const;
+    Selection invert() const;
+
+    Selection &operator&=(const Selection &other);
+    Selection &operator|=(const Selection &other);
+    friend Selection operator&(const Selection &left, const Selection &right) { return left.intersect(right); }
+    friend Selection operator|(const Selection &left, const Selection &right) { return left.unite(right); }
+    Selection operator~() const { return invert(); }
+    bool operator==(const Selection &other) const { return length == other.length && words == other.words; }
+    bool operator!=(const Selection &other) const { return !(*this == other); }
+
+    // (size() + 63) / 64 words, the unused bits of the last one are zero
+    std::uint64_t *data() { return words.data(); }
+    const std::uint64_t *data() const { return words.data(); }
+    const std::vector<std::uint64_t> &getWords() const { return words; }
+
+private:
+    void assertSameSize(const Selection &other) const;
+    void clearUnusedBits();
+
+    std::size_t length;
+    std::vector<std::uint64_t> words;
+};
+
+}
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include "unit.h"
 
 namespace Quantify {
@@ -196,5 +197,13 @@ public:
     static const Unit poundFoot;
 };
 
+// Every unit above, in declaration order
+class AllUnits
+{
+public:
+    static const Unit *const *getUnits();
+    static std::size_t getCount();
+};
+
 }
 }
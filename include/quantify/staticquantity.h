@@ -0,0 +1,183 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <ratio>
+#include <type_traits>
+#include "dimensions.h"
+#include "incompatibleunitsexception.h"
+#include "quantity.h"
+#include "unit.h"
+#include "utils.h"
+
+namespace Quantify {
+
+// Opt-in compile time counterpart of Quantity: the dimensions (packed, see
+// Dimensions::getPacked) and the factor (a std::ratio) are template arguments,
+// so an instance is a single double and dimension errors fail to compile.
+// Units with an offset are not representable.
+template<std::uint64_t PackedDimensions, typename Factor = std::ratio<1>>
+class StaticQuantity
+{
+    static_assert(std::is_same<Factor, typename Factor::type>::value, "The factor must be a reduced std::ratio, use std::ratio<N, D>::type");
+
+public:
+    constexpr StaticQuantity() : value(0) {}
+    constexpr explicit StaticQuantity(double value) : value(value) {}
+
+    template<typename OtherFactor>
+    constexpr explicit StaticQuantity(const StaticQuantity<PackedDimensions, OtherFactor> &other)
+        : value(other.getValue() * scale<OtherFactor, Factor>()) {}
+
+    explicit StaticQuantity(const Quantity &quantity) : value(valueOf(quantity)) {}
+
+    static constexpr Dimensions getDimensions() { return Dimensions::fromPacked(PackedDimensions); }
+    static constexpr double getFactor() { return (double) Factor::num / (double) Factor::den; }
+    static Unit getUnit()
+    {
+        static const Unit unit = Unit::fromDimensions(getDimensions(), Rational(Factor::num, Factor::den));
+        return unit;
+    }
+
+    constexpr double getValue() const { return value; }
+    void setValue(double value) { this->value = value; }
+
+    template<typename OtherFactor>
+    constexpr StaticQuantity<PackedDimensions, OtherFactor> convertTo() const
+    {
+        return StaticQuantity<PackedDimensions, OtherFactor>(*this);
+    }
+
+    Quantity toQuantity() const { return Quantity(getUnit(), value); }
+    Quantity toQuantity(const Unit &unit) const { return toQuantity().convertTo(unit); }
+    explicit operator Quantity() const { return toQuantity(); }
+
+    template<std::uint64_t OtherDimensions, typename OtherFactor>
+    constexpr StaticQuantity operator+(const StaticQuantity<OtherDimensions, OtherFactor> &other) const
+    {
+        static_assert(OtherDimensions == PackedDimensions, "Quantities with different dimensions cannot be added");
+        return StaticQuantity(value + other.getValue() * scale<OtherFactor, Factor>());
+    }
+
+    template<std::uint64_t OtherDimensions, typename OtherFactor>
+    constexpr StaticQuantity operator-(const StaticQuantity<OtherDimensions, OtherFactor> &other) const
+    {
+        static_assert(OtherDimensions == PackedDimensions, "Quantities with different dimensions cannot be subtracted");
+        return StaticQuantity(value - other.getValue() * scale<OtherFactor, Factor>());
+    }
+
+    template<std::uint64_t OtherDimensions, typename OtherFactor>
+    constexpr StaticQuantity<Dimensions::addPacked(PackedDimensions, OtherDimensions), std::ratio_multiply<Factor, OtherFactor>>
+    operator*(const StaticQuantity<OtherDimensions, OtherFactor> &other) const
+    {
+        static_assert(!Dimensions::addOverflows(PackedDimensions, OtherDimensions), "Dimensions overflow");
+        return StaticQuantity<Dimensions::addPacked(PackedDimensions, OtherDimensions), std::ratio_multiply<Factor, OtherFactor>>(value * other.getValue());
+    }
+
+    template<std::uint64_t OtherDimensions, typename OtherFactor>
+    constexpr StaticQuantity<Dimensions::subtractPacked(PackedDimensions, OtherDimensions), std::ratio_divide<Factor, OtherFactor>>
+    operator/(const StaticQuantity<OtherDimensions, OtherFactor> &other) const
+    {
+        static_assert(!Dimensions::subtractOverflows(PackedDimensions, OtherDimensions), "Dimensions overflow");
+        return StaticQuantity<Dimensions::subtractPacked(PackedDimensions, OtherDimensions), std::ratio_divide<Factor, OtherFactor>>(value / other.getValue());
+    }
+
+    constexpr StaticQuantity operator*(double other) const { return StaticQuantity(value * other); }
+    constexpr StaticQuantity operator/(double other) const { return StaticQuantity(value / other); }
+    friend constexpr StaticQuantity operator*(double left, const StaticQuantity &right) { return StaticQuantity(left * right.value); }
+    friend constexpr StaticQuantity<Dimensions::subtractPacked(0, PackedDimensions), std::ratio_divide<std::ratio<1>, Factor>>
+    operator/(double left, const StaticQuantity &right)
+    {
+        return StaticQuantity<Dimensions::subtractPacked(0, PackedDimensions), std::ratio_divide<std::ratio<1>, Factor>>(left / right.value);
+    }
+
+    StaticQuantity &operator+=(const StaticQuantity &other) { value += other.value; return *this; }
+    StaticQuantity &operator-=(const StaticQuantity &other) { value -= other.value; return *this; }
+    StaticQuantity &operator*=(double other) { value *= other; return *this; }
+    StaticQuantity &operator/=(double other) { value /= other; return *this; }
+
+    template<typename OtherFactor>
+    bool operator==(const StaticQuantity<PackedDimensions, OtherFactor> &other) const { return Utils::areEqual(value, StaticQuantity(other).value); }
+    template<typename OtherFactor>
+    bool operator!=(const StaticQuantity<PackedDimensions, OtherFactor> &other) const { return !(*this == other); }
+    template<typename OtherFactor>
+    constexpr bool operator<(const StaticQuantity<PackedDimensions, OtherFactor> &other) const { return value < StaticQuantity(other).value; }
+    template<typename OtherFactor>
+    constexpr bool operator>(const StaticQuantity<PackedDimensions, OtherFactor> &other) const { return value > StaticQuantity(other).value; }
+    template<typename OtherFactor>
+    bool operator<=(const StaticQuantity<PackedDimensions, OtherFactor> &other) const { return (*this < other) || (*this == other); }
+    template<typename OtherFactor>
+    bool operator>=(const StaticQuantity<PackedDimensions, OtherFactor> &other) const { return (*this > other) || (*this == other); }
+
+    friend std::ostream& operator <<(std::ostream& outputStream, const StaticQuantity& quantity)
+    {
+        outputStream << quantity.value << " " << getUnit();
+        return outputStream;
+    }
+
+private:
+    template<typename From, typename To>
+    static constexpr double scale()
+    {
+        return (double) std::ratio_divide<From, To>::num / (double) std::ratio_divide<From, To>::den;
+    }
+
+    static double valueOf(const Quantity &quantity)
+    {
+        const Unit unit = quantity.getUnit();
+
+        if(unit.getDimensions() != getDimensions())
+        {
+            throw IncompatibleUnitsException(unit, getUnit());
+        }
+
+        return (unit.getFactor() * quantity.getValue() + unit.getOffset()) / getFactor();
+    }
+
+    double value;
+};
+
+namespace StaticQuantities {
+
+typedef StaticQuantity<Dimensions().getPacked()> Scalar;
+typedef StaticQuantity<Dimensions(1).getPacked()> Meters;
+typedef StaticQuantity<Dimensions(1).getPacked(), std::kilo> Kilometers;
+typedef StaticQuantity<Dimensions(0, 1).getPacked()> Kilograms;
+typedef StaticQuantity<Dimensions(0, 0, 1).getPacked()> Seconds;
+typedef StaticQuantity<Dimensions(0, 0, 1).getPacked(), std::ratio<3600>> Hours;
+typedef StaticQuantity<Dimensions(0, 0, 0, 1).getPacked()> Amperes;
+typedef StaticQuantity<Dimensions(0, 0, 0, 0, 1).getPacked()> Kelvins;
+typedef StaticQuantity<Dimensions(2).getPacked()> SquareMeters;
+typedef StaticQuantity<Dimensions(1, 0, -1).getPacked()> MetersPerSecond;
+typedef StaticQuantity<Dimensions(1, 0, -1).getPacked(), std::ratio<1000, 3600>::type> KilometersPerHour;
+typedef StaticQuantity<Dimensions(1, 1, -2).getPacked()> Newtons;
+typedef StaticQuantity<Dimensions(2, 1, -2).getPacked()> Joules;
+typedef StaticQuantity<Dimensions(2, 1, -3).getPacked()> Watts;
+
+}
+
+}
@@ -24,24 +24,39 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <string>
-#include <sstream>
 #include <ostream>
 #include "dimensions.h"
+#include "operationstatus.h"
+#include "unitbody.h"
+#include "unitlabel.h"
 
 namespace Quantify {
 
+// Handle to an immutable, shared UnitBody: copies only touch a reference
+// count (none for standard units), moves swap the handle with the shared
+// empty body, and setters replace the body instead of modifying it.
 class Unit
 {
-public:        
-    Unit(std::string name = "", std::string symbol = "", Dimensions dimensions = Dimensions(), double factor = 1.0, double offset = 0.0);
-    Unit(std::string name, std::string symbol, Unit baseUnit) : Unit(name, symbol, baseUnit.getDimensions(), baseUnit.getFactor(), baseUnit.getOffset()){}
-    Unit(const Unit &other);
-    Unit(Unit &&other);
+public:
+    constexpr Unit() : body(&UnitBody::empty) {}
+    Unit(std::string name, std::string symbol = "", Dimensions dimensions = Dimensions(), double factor = 1.0, double offset = 0.0);
+    Unit(std::string name, std::string symbol, Dimensions dimensions, const Rational &factor, double offset = 0.0);
+    Unit(std::string name, std::string symbol, const Unit &baseUnit);
+    // body must outlive the unit, typically a constant initialized static body
+    constexpr Unit(const UnitBody &body) : body(&body) {}
+    Unit(const Unit &other) noexcept = default;
+    Unit(Unit &&other) noexcept : body(&UnitBody::empty) { body.swap(other.body); }
     ~Unit() noexcept {}
 
-    Unit &operator=(const Unit &other);
-    Unit &operator=(Unit &&other);
+    Unit &operator=(const Unit &other) noexcept = default;
+    Unit &operator=(Unit &&other) noexcept { body.swap(other.body); return *this; }
+
+    static Unit fromDimensions(const Dimensions &dimensions, double factor = 1.0);
+    static Unit fromDimensions(const Dimensions &dimensions, const Rational &factor);
 
     void assertCompatibility(const Unit &other) const;
     void assertCanMultiply() const;
@@ -58,6 +73,11 @@ public:
     Unit divideBy(const Unit &other) const;
     Unit divideBy(double value) const;
 
+    // non throwing variants, result is only assigned on OperationStatus::Ok
+    OperationStatus tryPower(int power, Unit &result) const;
+    OperationStatus tryMultiplyBy(const Unit &other, Unit &result) const;
+    OperationStatus tryDivideBy(const Unit &other, Unit &result) const;
+
     bool operator==(const Unit &other) const { return equals(other); }
     bool operator!=(const Unit &other) const { return !equals(other); }
     bool operator<(const Unit &other) const { return lessThan(other); }
@@ -73,45 +93,51 @@ public:
     friend Unit operator*(double left, const Unit &right) { return right.multiplyBy(left); }
     friend Unit operator/(const Unit &left, const Unit &right) { return left.divideBy(right); }
     friend Unit operator/(const Unit &left, double right) { return left.divideBy(right); }
-    friend Unit operator/(double left, const Unit &right)
-    {
-        right.assertCanDivide();
-
-        std::stringstream nameStream;
-        nameStream << left << "/" << right.getName();
-
-        std::stringstream symbolStream;
-        symbolStream << left << "/" << right.getSymbol();
-
-        return Unit(nameStream.str(), symbolStream.str(), right.getDimensions().power(-1), left / right.getFactor());
-    }    
+    friend Unit operator/(double left, const Unit &right);
     friend std::ostream& operator <<(std::ostream& outputStream, const Unit& unit)
     {
-        outputStream << unit.getSymbol();
+        if(unit.body->getLabel())
+            unit.body->getLabel()->writeSymbol(outputStream);
+
         return outputStream;
     }
 
-    std::string getName() const;
-    std::string getSymbol() const;
-    double getFactor() const;
-    double getOffset() const;
-    Dimensions getDimensions() const;    
+    const std::string &getName() const;
+    const std::string &getSymbol() const;
+    double getFactor() const { return body->getFactor(); }
+    double getOffset() const { return body->getOffset(); }
+    const Dimensions &getDimensions() const { return body->getDimensions(); }
+    // exact factor folded through compositions, not valid when unknown
+    const Rational &getExactFactor() const { return body->getExactFactor(); }
+    std::uint32_t getId() const { return body->getId(); }
 
     void setName(const std::string &value);
     void setSymbol(const std::string &value);
     void setFactor(double value);
     void setOffset(double value);
-    void setDimensions(const Dimensions &value);        
+    void setDimensions(const Dimensions &value);
 
 private:
-    void copyFrom(const Unit &other);
-    void moveFrom(Unit &other);
-
-    std::string name;
-    std::string symbol;
-    double factor;
-    double offset;
-    Dimensions dimensions;
+    friend class CompositionCache;
+
+    Unit(UnitLabel::Pointer label, const Dimensions &dimensions, double factor, double offset, const Rational &exactFactor);
+
+    const UnitLabel::Pointer &getLabel() const { return body->getLabel(); }
+
+    UnitBody::Pointer body;
+};
+
+}
+
+namespace std {
+
+template<>
+struct hash<Quantify::Unit>
+{
+    std::size_t operator()(const Quantify::Unit &unit) const
+    {
+        return std::hash<std::uint32_t>()(unit.getId());
+    }
 };
 
 }
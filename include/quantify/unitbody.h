@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "dimensions.h"
+#include "intrusivepointer.h"
+#include "rational.h"
+#include "unitlabel.h"
+
+namespace Quantify {
+
+// Immutable state shared by every copy of a unit, so a Unit is a single
+// pointer. Bodies built by the constexpr constructor are not reference
+// counted, like static labels, and must outlive the units referencing them.
+// The factor is also kept as an exact Rational when known, compositions fold
+// it and the double factor is always its rounding.
+class UnitBody
+{
+public:
+    typedef IntrusivePointer<UnitBody> Pointer;
+
+    constexpr UnitBody(const UnitLabel *label, Dimensions dimensions, double factor, double offset = 0.0)
+        : label(label), factor(factor), offset(offset), dimensions(dimensions), exactFactor(), id(0), counted(false), references(0) {}
+    constexpr UnitBody(const UnitLabel *label, Dimensions dimensions, Rational exactFactor = Rational(1), double offset = 0.0)
+        : label(label), factor(exactFactor.toDouble()), offset(offset), dimensions(dimensions), exactFactor(exactFactor), id(0), counted(false), references(0) {}
+    UnitBody(UnitLabel::Pointer label, const Dimensions &dimensions, double factor, double offset, const Rational &exactFactor);
+    UnitBody(const UnitBody &other) = delete;
+
+    UnitBody &operator=(const UnitBody &other) = delete;
+
+    // dimensionless body without label, shared by default constructed units
+    static const UnitBody empty;
+
+    const UnitLabel::Pointer &getLabel() const { return label; }
+    double getFactor() const { return factor; }
+    double getOffset() const { return offset; }
+    const Dimensions &getDimensions() const { return dimensions; }
+    const Rational &getExactFactor() const { return exactFactor; }
+    std::uint32_t getId() const
+    {
+        const std::uint32_t value = id.load(std::memory_order_relaxed);
+        return value ? value : intern();
+    }
+
+private:
+    friend class IntrusivePointer<UnitBody>;
+
+    static void destroy(const UnitBody *object);
+
+    std::uint32_t intern() const;
+
+    UnitLabel::Pointer label;
+    double factor;
+    double offset;
+    Dimensions dimensions;
+    Rational exactFactor;
+    mutable std::atomic<std::uint32_t> id;
+    bool counted;
+    mutable std::atomic<unsigned int> references;
+};
+
+}
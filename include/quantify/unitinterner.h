@@ -0,0 +1,48 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "dimensions.h"
+
+namespace Quantify {
+
+// Hash-consing of unit definitions: every distinct (dimensions, factor, offset)
+// gets a stable small id. Factors and offsets are first rounded to 40
+// significant bits (a relative step of about 1e-12), so units built through
+// different compositions (meter * meter and meter^2, hertz and 1 / second, ...)
+// compare as equal. The rounding only depends on the value itself, so unit
+// equality is transitive and does not depend on the order units are created.
+// The table keeps one entry per distinct rounded definition for the lifetime
+// of the process; ids are 32 bit and running out of them throws.
+class UnitInterner
+{
+public:
+    static std::uint32_t intern(const Dimensions &dimensions, double factor, double offset);
+    static std::size_t size();
+};
+
+}
@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <string>
+#include "intrusivepointer.h"
+
+namespace Quantify {
+
+// Symbolic description of a unit name and symbol. Composed units only keep
+// their operands and the operator, the text is rendered when requested.
+// Labels built from string literals (constexpr constructor) are never
+// reference counted, so they can be constant initialized and shared freely.
+// The rendered name and symbol are cached on first use, so they can be
+// returned by reference.
+class UnitLabel
+{
+public:
+    enum class Operation
+    {
+        None,
+        Multiply,
+        Divide,
+        Power,
+        Add,
+        Subtract,
+        MultiplyByValue,
+        DivideByValue,
+        ValueDividedBy
+    };
+
+    typedef IntrusivePointer<UnitLabel> Pointer;
+
+    constexpr UnitLabel(const char *name, const char *symbol)
+        : operation(Operation::None), name(name), symbol(symbol), text(), left(), right(), value(0), power(0), renderedName(nullptr), renderedSymbol(nullptr), counted(false), references(0) {}
+    UnitLabel(const std::string &name, const std::string &symbol);
+    UnitLabel(Operation operation, Pointer left, Pointer right);
+    UnitLabel(Operation operation, Pointer operand, double value);
+    UnitLabel(Pointer operand, int power);
+    UnitLabel(const UnitLabel &other) = delete;
+    ~UnitLabel();
+
+    UnitLabel &operator=(const UnitLabel &other) = delete;
+
+    const std::string &getName() const;
+    const std::string &getSymbol() const;
+    Operation getOperation() const;
+
+    void writeName(std::ostream &outputStream) const;
+    void writeSymbol(std::ostream &outputStream) const;
+
+private:
+    friend class IntrusivePointer<UnitLabel>;
+
+    static void destroy(const UnitLabel *object);
+
+    const std::string &getText(std::atomic<const std::string*> &rendered, bool symbol) const;
+    static void write(std::ostream &outputStream, const Pointer &label, bool symbol);
+    void write(std::ostream &outputStream, bool symbol) const;
+
+    Operation operation;
+    const char *name;
+    const char *symbol;
+    std::unique_ptr<char[]> text;
+    Pointer left;
+    Pointer right;
+    double value;
+    int power;
+    mutable std::atomic<const std::string*> renderedName;
+    mutable std::atomic<const std::string*> renderedSymbol;
+    bool counted;
+    mutable std::atomic<unsigned int> references;
+};
+
+}
@@ -0,0 +1,64 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <sstream>
+#include <string>
+#include "lazymessage.h"
+
+namespace Quantify {
+
+class UnitParseException : public std::exception
+{
+public:
+
+    UnitParseException(const std::string &expression, std::size_t position, const char *reason)
+        : expression(expression), position(position), reason(reason) {}
+
+    virtual const char *what() const throw()
+    {
+        return message.get([this]() -> std::string
+        {
+            std::stringstream ss;
+            ss << "Cannot parse unit \"" << expression << "\" at position " << position << " : " << reason << ".";
+
+            return ss.str();
+        }, "Cannot parse unit.");
+    }
+
+    const std::string &getExpression() const { return expression; }
+    std::size_t getPosition() const { return position; }
+    const char *getReason() const { return reason; }
+
+private:
+    std::string expression;
+    std::size_t position;
+    const char *reason;
+    LazyMessage message;
+};
+
+}
@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "unit.h"
+
+namespace Quantify {
+
+// Builds units from expressions such as "kg*m/s^2", "N m", "(km/h)^-1" or
+// "mW". Identifiers resolve through UnitRegistry::getDefault(), which holds
+// the standard units and the units added with addUnit, by symbol, then by
+// name, then as an SI prefix followed by a symbol. Parsed expressions are
+// kept in a bounded LRU cache keyed by the raw text, shared by all threads.
+class UnitParser
+{
+public:
+    struct Statistics
+    {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::size_t size;
+        std::size_t capacity;
+    };
+
+    static Unit parse(const std::string &expression);
+    static void addUnit(const Unit &unit);
+    // generation of the default registry, lets derived caches notice new units
+    static std::uint32_t getGeneration();
+
+    static Statistics getStatistics();
+    static void setCacheCapacity(std::size_t value);
+    static void clearCache();
+};
+
+}
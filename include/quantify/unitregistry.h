@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "dimensions.h"
+#include "intrusivepointer.h"
+#include "unit.h"
+
+#define QUANTIFY_UNIT_REGISTRY_READER_STRIPES 16
+
+namespace Quantify {
+
+// Index of units by symbol, by name and by dimensions. Symbols and names are
+// looked up in open addressing hash tables, units sharing the same dimensions
+// are stored next to each other so compatible units come back as one range.
+// A unit replaces any registered unit with the same symbol or name.
+// Lookups never lock: they read an immutable snapshot that add replaces
+// atomically. Readers announce themselves in per-epoch counters, and add waits
+// for the readers of the previous epoch to leave before releasing the
+// replaced snapshot. Symbol and name lookups copy the unit out, ranges keep
+// their snapshot alive until they are destroyed.
+class UnitRegistry
+{
+    class Snapshot;
+    typedef IntrusivePointer<Snapshot> SnapshotPointer;
+
+public:
+    class Range
+    {
+    public:
+        Range();
+        Range(const Range &other);
+        Range(Range &&other) noexcept;
+        ~Range() noexcept;
+
+        Range &operator=(const Range &other);
+        Range &operator=(Range &&other) noexcept;
+
+        const Unit *begin() const { return first; }
+        const Unit *end() const { return last; }
+        std::size_t size() const { return (std::size_t) (last - first); }
+        bool empty() const { return first == last; }
+        const Unit &operator[](std::size_t index) const { return first[index]; }
+
+    private:
+        friend class UnitRegistry;
+
+        Range(SnapshotPointer snapshot, const Unit *first, const Unit *last);
+
+        SnapshotPointer snapshot;
+        const Unit *first;
+        const Unit *last;
+    };
+
+    UnitRegistry();
+    UnitRegistry(const UnitRegistry &other) = delete;
+    ~UnitRegistry() noexcept;
+
+    UnitRegistry &operator=(const UnitRegistry &other) = delete;
+
+    // the standard units, shared by UnitParser and QuantityParser
+    static UnitRegistry &getDefault();
+    // snapshots alive in the process: the published one of every registry
+    // plus the replaced ones still referenced by a Range
+    static std::size_t getSnapshotCount();
+
+    void add(const Unit &unit);
+    void add(const std::vector<Unit> &units);
+    void addStandardUnits();
+
+    // unit is only assigned when found
+    bool findBySymbol(const char *symbol, std::size_t length, Unit &unit) const;
+    bool findBySymbol(const std::string &symbol, Unit &unit) const;
+    bool findByName(const char *name, std::size_t length, Unit &unit) const;
+    bool findByName(const std::string &name, Unit &unit) const;
+    Range findByDimensions(const Dimensions &dimensions) const;
+    Range getUnits() const;
+    std::size_t size() const;
+    // incremented by every add, lets derived caches notice the registry changed
+    std::uint32_t getGeneration() const;
+
+private:
+    // reader counter of one epoch parity, padded to its own cache line so
+    // threads on different stripes do not share it
+    struct ReaderCount
+    {
+        std::atomic<unsigned int> count;
+        char padding[64 - sizeof(std::atomic<unsigned int>)];
+    };
+
+    std::size_t enter() const;
+    void leave(std::size_t reader) const;
+    void waitForReaders(std::uint32_t previousEpoch) const;
+
+    std::atomic<const Snapshot *> snapshot;
+    std::atomic<std::uint32_t> epoch;
+    mutable ReaderCount readers[2 * QUANTIFY_UNIT_REGISTRY_READER_STRIPES];
+    std::mutex mutex;
+};
+
+}
@@ -26,36 +26,42 @@
 
 #include <exception>
 #include <sstream>
+#include <string>
+#include "lazymessage.h"
 #include "unit.h"
 #include "utils.h"
 
 namespace Quantify {
 
+// operation must be a string literal, the message is formatted by what()
 class UnitUnsupportedOperationException : public std::exception
 {
 public:
 
-    UnitUnsupportedOperationException(const Unit &unit, const char *operation) : unit(unit), operation(operation)
+    UnitUnsupportedOperationException(const Unit &unit, const char *operation) : unit(unit), operation(operation) {}
+
+    virtual const char* what() const throw()
     {
-        std::stringstream ss;
-        ss << "Unit \"" << unit.getSymbol() << "\" does not support operation \"" << operation << "\".";
-        if(!Utils::areEqual(unit.getOffset(), 0))
+        return message.get([this]() -> std::string
         {
-            ss << " Hint : units with an offset different from 0 do not support multiplication nor division.";
-        }
+            std::stringstream ss;
+            ss << "Unit \"" << unit.getSymbol() << "\" does not support operation \"" << operation << "\".";
+            if(!Utils::areEqual(unit.getOffset(), 0))
+            {
+                ss << " Hint : units with an offset different from 0 do not support multiplication nor division.";
+            }
 
-        message = std::move(ss.str());
+            return ss.str();
+        }, "Unit does not support the operation.");
     }
 
-    virtual const char* what() const throw()
-    {        
-        return message.c_str();
-    }
+    const Unit &getUnit() const { return unit; }
+    const char *getOperation() const { return operation; }
 
-private:    
-    const Unit &unit;
+private:
+    Unit unit;
     const char *operation;
-    std::string message;
+    LazyMessage message;
 };
 
 }
@@ -33,6 +33,10 @@ class Utils
 {
 public:
     static bool areEqual(double a, double b){ return fabs(a - b) < DBL_EPSILON;}
+    static bool areClose(double a, double b, double relativeTolerance)
+    {
+        return fabs(a - b) <= fmax(DBL_EPSILON, relativeTolerance * fmax(fabs(a), fabs(b)));
+    }
     static double round(double a, int decimals)
     {
         double factor = pow(10, decimals);
@@ -0,0 +1,160 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/batchnormalizer.h>
+#include <quantify/converter.h>
+#include <cstdint>
+#include <unordered_map>
+
+#define QUANTIFY_BATCH_NORMALIZER_SCAN_GROUPS 16
+
+namespace Quantify {
+
+namespace {
+
+// Group of each distinct unit id in the batch. Batches usually hold a few
+// units, found by a linear scan; past QUANTIFY_BATCH_NORMALIZER_SCAN_GROUPS
+// the ids move to a hash map. Both only grow with the units of the batch.
+class GroupIndex
+{
+public:
+    // group of id, a new group numbered size() when the id is new
+    std::uint32_t find(std::uint32_t id, bool &added)
+    {
+        added = false;
+
+        if(ids.size() <= QUANTIFY_BATCH_NORMALIZER_SCAN_GROUPS)
+        {
+            for(std::uint32_t group=0; group<ids.size(); ++group)
+            {
+                if(ids[group] == id)
+                    return group;
+            }
+        }
+        else
+        {
+            auto it = groupOfId.find(id);
+            if(it != groupOfId.end())
+                return it->second;
+        }
+
+        const std::uint32_t group = (std::uint32_t) ids.size();
+        ids.push_back(id);
+        added = true;
+
+        if(ids.size() > QUANTIFY_BATCH_NORMALIZER_SCAN_GROUPS)
+        {
+            if(groupOfId.empty())
+            {
+                for(std::uint32_t i=0; i<ids.size(); ++i)
+                    groupOfId[ids[i]] = i;
+            }
+            else
+            {
+                groupOfId[id] = group;
+            }
+        }
+
+        return group;
+    }
+
+private:
+    std::vector<std::uint32_t> ids;
+    std::unordered_map<std::uint32_t, std::uint32_t> groupOfId;
+};
+
+}
+
+void BatchNormalizer::normalize(const Quantity *quantities, std::size_t count, const Unit &unit, double *output)
+{
+    if(count == 0)
+        return;
+
+    GroupIndex groupIndex;
+    std::vector<const Unit*> groupUnits;
+    std::vector<std::size_t> groupSizes;
+    std::vector<std::uint32_t> groups(count);
+    std::uint32_t lastId = 0;
+    std::uint32_t lastGroup = 0;
+
+    for(std::size_t i=0; i<count; ++i)
+    {
+        const std::uint32_t id = quantities[i].getUnit().getId();
+        if(id != lastId)
+        {
+            bool added = false;
+            lastGroup = groupIndex.find(id, added);
+            if(added)
+            {
+                groupUnits.push_back(&quantities[i].getUnit());
+                groupSizes.push_back(0);
+            }
+
+            lastId = id;
+        }
+
+        groups[i] = lastGroup;
+        ++groupSizes[lastGroup];
+    }
+
+    std::vector<Converter> converters;
+    converters.reserve(groupUnits.size());
+    for(const Unit *groupUnit : groupUnits)
+        converters.emplace_back(*groupUnit, unit);
+
+    if(converters.size() == 1)
+    {
+        for(std::size_t i=0; i<count; ++i)
+            output[i] = quantities[i].getValue();
+        converters.front().convert(output, count);
+
+        return;
+    }
+
+    std::vector<std::size_t> offsets(groupSizes.size() + 1, 0);
+    for(std::size_t group=0; group<groupSizes.size(); ++group)
+        offsets[group + 1] = offsets[group] + groupSizes[group];
+
+    std::vector<double> buffer(count);
+    std::vector<std::size_t> cursors(offsets.begin(), offsets.end() - 1);
+    for(std::size_t i=0; i<count; ++i)
+        buffer[cursors[groups[i]]++] = quantities[i].getValue();
+
+    for(std::size_t group=0; group<converters.size(); ++group)
+        converters[group].convert(buffer.data() + offsets[group], groupSizes[group]);
+
+    cursors.assign(offsets.begin(), offsets.end() - 1);
+    for(std::size_t i=0; i<count; ++i)
+        output[i] = buffer[cursors[groups[i]]++];
+}
+
+QuantityArray BatchNormalizer::normalize(const std::vector<Quantity> &quantities, const Unit &unit)
+{
+    std::vector<double> values(quantities.size());
+    normalize(quantities.data(), quantities.size(), unit, values.data());
+
+    return QuantityArray(unit, std::move(values));
+}
+
+}
@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/compositioncache.h>
+#include <quantify/lrucache.h>
+
+#define QUANTIFY_COMPOSITION_CACHE_SHARDS 16
+#define QUANTIFY_COMPOSITION_CACHE_CAPACITY 4096
+
+namespace Quantify {
+
+namespace {
+
+struct CompositionKey
+{
+    UnitLabel::Operation operation;
+    std::uint32_t leftId;
+    std::uint32_t rightId;
+    const UnitLabel *leftLabel;
+    const UnitLabel *rightLabel;
+    int power;
+
+    bool operator==(const CompositionKey &other) const
+    {
+        return operation == other.operation && leftId == other.leftId && rightId == other.rightId
+               && leftLabel == other.leftLabel && rightLabel == other.rightLabel && power == other.power;
+    }
+};
+
+struct CompositionKeyHash
+{
+    std::size_t operator()(const CompositionKey &key) const
+    {
+        std::size_t hash = (std::size_t) key.operation;
+        hash = hash * 31 + key.leftId;
+        hash = hash * 31 + key.rightId;
+        hash = hash * 31 + std::hash<const void *>()(key.leftLabel);
+        hash = hash * 31 + std::hash<const void *>()(key.rightLabel);
+        hash = hash * 31 + (std::size_t) key.power;
+
+        return hash;
+    }
+};
+
+typedef LruCache<CompositionKey, Unit, CompositionKeyHash> CompositionShard;
+
+class CompositionShards
+{
+public:
+    CompositionShards()
+    {
+        for(CompositionShard &shard : shards)
+            shard.setCapacity(QUANTIFY_COMPOSITION_CACHE_CAPACITY / QUANTIFY_COMPOSITION_CACHE_SHARDS);
+    }
+
+    CompositionShard shards[QUANTIFY_COMPOSITION_CACHE_SHARDS];
+};
+
+CompositionShard *shards()
+{
+    static CompositionShards instance;
+    return instance.shards;
+}
+
+CompositionShard &shardOf(const CompositionKey &key)
+{
+    return shards()[(CompositionKeyHash()(key) >> 4) % QUANTIFY_COMPOSITION_CACHE_SHARDS];
+}
+
+}
+
+bool CompositionCache::find(UnitLabel::Operation operation, const Unit &left, const Unit &right, int power, Unit &result)
+{
+    const CompositionKey key = {operation, left.getId(), right.getId(), left.getLabel().get(), right.getLabel().get(), power};
+    return shardOf(key).get(key, result);
+}
+
+void CompositionCache::insert(UnitLabel::Operation operation, const Unit &left, const Unit &right, int power, const Unit &result)
+{
+    // the cached result keeps the operand labels alive, so their addresses
+    // cannot be reused by another label while the entry exists
+    const CompositionKey key = {operation, left.getId(), right.getId(), left.getLabel().get(), right.getLabel().get(), power};
+
+    result.getId();
+    shardOf(key).put(key, result);
+}
+
+CompositionCache::Statistics CompositionCache::getStatistics()
+{
+    Statistics statistics = {0, 0, 0, 0};
+
+    for(int i=0; i<QUANTIFY_COMPOSITION_CACHE_SHARDS; ++i)
+    {
+        statistics.hits += shards()[i].getHits();
+        statistics.misses += shards()[i].getMisses();
+        statistics.size += shards()[i].size();
+        statistics.capacity += shards()[i].getCapacity();
+    }
+
+    return statistics;
+}
+
+void CompositionCache::setCapacity(std::size_t value)
+{
+    const std::size_t perShard = (value + QUANTIFY_COMPOSITION_CACHE_SHARDS - 1) / QUANTIFY_COMPOSITION_CACHE_SHARDS;
+
+    for(int i=0; i<QUANTIFY_COMPOSITION_CACHE_SHARDS; ++i)
+        shards()[i].setCapacity(perShard);
+}
+
+void CompositionCache::clear()
+{
+    for(int i=0; i<QUANTIFY_COMPOSITION_CACHE_SHARDS; ++i)
+        shards()[i].clear();
+}
+
+}
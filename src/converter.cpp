@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/converter.h>
+#include <quantify/kernels.h>
+#include <quantify/quantity.h>
+
+namespace Quantify {
+
+Converter::Converter(const Unit &from, const Unit &to) : from(from), to(to)
+{
+    from.assertCompatibility(to);
+
+    // exact factors are divided before rounding, chains of compositions then
+    // cost a single rounding instead of one per step
+    const Rational exactScale = from.getExactFactor().divideBy(to.getExactFactor());
+    scale = exactScale.isValid() ? exactScale.toDouble() : from.getFactor() / to.getFactor();
+    bias = (from.getOffset() - to.getOffset()) / to.getFactor();
+}
+
+Quantity Converter::convert(const Quantity &quantity) const
+{
+    if(quantity.getUnit() != from)
+    {
+        return quantity.convertTo(to);
+    }
+
+    return Quantity(to, convert(quantity.getValue()));
+}
+
+void Converter::convert(const double *input, double *output, std::size_t count) const
+{
+    Kernels::affine(input, output, count, scale, bias);
+}
+
+void Converter::convert(double *values, std::size_t count) const
+{
+    convert(values, values, count);
+}
+
+std::vector<double> Converter::convert(const std::vector<double> &values) const
+{
+    std::vector<double> result(values.size());
+    convert(values.data(), result.data(), values.size());
+
+    return result;
+}
+
+bool Converter::isIdentity() const
+{
+    return scale == 1.0 && bias == 0.0;
+}
+
+Unit Converter::getFrom() const
+{
+    return from;
+}
+
+Unit Converter::getTo() const
+{
+    return to;
+}
+
+double Converter::getScale() const
+{
+    return scale;
+}
+
+double Converter::getBias() const
+{
+    return bias;
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/convertercache.h>
+#include <quantify/converter.h>
+#include <algorithm>
+
+namespace Quantify {
+
+ConverterCache::ConverterCache(const Unit &to) : to(to), next(0), last(0)
+{
+    std::fill(ids, ids + QUANTIFY_CONVERTER_CACHE_SLOTS, 0);
+}
+
+double ConverterCache::convertUncached(const Quantity &quantity, std::uint32_t id)
+{
+    const Converter converter(quantity.getUnit(), to);
+    ids[next] = id;
+    scales[next] = converter.getScale();
+    biases[next] = converter.getBias();
+    last = next;
+    next = (next + 1) % QUANTIFY_CONVERTER_CACHE_SLOTS;
+
+    return converter.convert(quantity.getValue());
+}
+
+}
@@ -23,178 +23,100 @@
  */
 
 #include <quantify/dimensions.h>
-#include <cstring>
+#include <quantify/dimensionsoverflowexception.h>
 
 namespace Quantify {
 
-Dimensions::Dimensions(char length, char mass, char time, char electricCurrent, char thermodynamicTemperature, char amountOfSubstance, char luminousIntensity)
-{
-    setLength(length);
-    setMass(mass);
-    setTime(time);
-    setElectricCurrent(electricCurrent);
-    setThermodynamicTemperature(thermodynamicTemperature);
-    setAmountOfSubstance(amountOfSubstance);
-    setLuminousIntensity(luminousIntensity);
-}
-
-Dimensions::Dimensions(const Dimensions &other)
-{
-    copyFrom(other);
-}
-
-Dimensions::Dimensions(Dimensions &&other)
-{
-    moveFrom(other);
-}
-
-Dimensions &Dimensions::operator=(const Dimensions &other)
-{
-    if(this != &other)
-    {
-        copyFrom(other);
-    }
-
-    return *this;
-}
-
-Dimensions &Dimensions::operator=(Dimensions &&other)
-{
-    if(this != &other)
-    {
-        moveFrom(other);
-    }
-
-    return *this;
-}
-
-char Dimensions::getLength() const
-{
-    return dimensions[QUANTIFY_DIMENSIONS_LENGTH_ID];
-}
-
-char Dimensions::getMass() const
-{
-    return dimensions[QUANTIFY_DIMENSIONS_MASS_ID];
-}
-
-char Dimensions::getTime() const
-{
-    return dimensions[QUANTIFY_DIMENSIONS_TIME_ID];
-}
-
-char Dimensions::getElectricCurrent() const
-{
-    return dimensions[QUANTIFY_DIMENSIONS_ELECTRIC_CURRENT_ID];
-}
-
-char Dimensions::getThermodynamicTemperature() const
-{
-    return dimensions[QUANTIFY_DIMENSIONS_THERMODYNAMIC_TEMPERATURE_ID];
-}
-
-char Dimensions::getAmountOfSubstance() const
-{
-    return dimensions[QUANTIFY_DIMENSIONS_AMOUNT_OF_SUBSTANCE_ID];
-}
-
-char Dimensions::getLuminousIntensity() const
-{
-   return dimensions[QUANTIFY_DIMENSIONS_LUMINOUS_INTENSITY_ID];
-}
-
 void Dimensions::setLength(char value)
 {
-    dimensions[QUANTIFY_DIMENSIONS_LENGTH_ID] = value;
+    set(QUANTIFY_DIMENSIONS_LENGTH_ID, value);
 }
 
 void Dimensions::setMass(char value)
 {
-    dimensions[QUANTIFY_DIMENSIONS_MASS_ID] = value;
+    set(QUANTIFY_DIMENSIONS_MASS_ID, value);
 }
 
 void Dimensions::setTime(char value)
 {
-    dimensions[QUANTIFY_DIMENSIONS_TIME_ID] = value;
+    set(QUANTIFY_DIMENSIONS_TIME_ID, value);
 }
 
 void Dimensions::setElectricCurrent(char value)
 {
-    dimensions[QUANTIFY_DIMENSIONS_ELECTRIC_CURRENT_ID] = value;
+    set(QUANTIFY_DIMENSIONS_ELECTRIC_CURRENT_ID, value);
 }
 
 void Dimensions::setThermodynamicTemperature(char value)
 {
-    dimensions[QUANTIFY_DIMENSIONS_THERMODYNAMIC_TEMPERATURE_ID] = value;
+    set(QUANTIFY_DIMENSIONS_THERMODYNAMIC_TEMPERATURE_ID, value);
 }
 
 void Dimensions::setAmountOfSubstance(char value)
 {
-    dimensions[QUANTIFY_DIMENSIONS_AMOUNT_OF_SUBSTANCE_ID] = value;
+    set(QUANTIFY_DIMENSIONS_AMOUNT_OF_SUBSTANCE_ID, value);
 }
 
 void Dimensions::setLuminousIntensity(char value)
 {
-    dimensions[QUANTIFY_DIMENSIONS_LUMINOUS_INTENSITY_ID] = value;
+    set(QUANTIFY_DIMENSIONS_LUMINOUS_INTENSITY_ID, value);
 }
 
-bool Dimensions::equals(const Dimensions &other) const
+void Dimensions::set(int id, char value)
 {
-    return memcmp(&dimensions, &(other.dimensions), QUANTIFY_DIMENSIONS_COUNT) == 0;
+    packed = (packed & ~lane((char) 0xFF, id)) | lane(value, id);
 }
 
 Dimensions Dimensions::multiplyBy(const Dimensions &other) const
 {
-    Dimensions result = *this;
-
-    for(int i=0; i<QUANTIFY_DIMENSIONS_COUNT; ++i)
-        result.dimensions[i] += other.dimensions[i];
+    if(addOverflows(packed, other.packed))
+    {
+        throw DimensionsOverflowException(*this, other, "*");
+    }
 
-    return result;
+    return fromPacked(addPacked(packed, other.packed));
 }
 
 Dimensions Dimensions::divideBy(const Dimensions &other) const
 {
-    Dimensions result = *this;
-
-    for(int i=0; i<QUANTIFY_DIMENSIONS_COUNT; ++i)
-        result.dimensions[i] -= other.dimensions[i];
+    if(subtractOverflows(packed, other.packed))
+    {
+        throw DimensionsOverflowException(*this, other, "/");
+    }
 
-    return result;
+    return fromPacked(subtractPacked(packed, other.packed));
 }
 
 Dimensions Dimensions::power(int power) const
 {
-    Dimensions result = *this;
+    if(powerOverflows(power))
+    {
+        throw DimensionsOverflowException(*this, power);
+    }
+
+    Dimensions result;
 
     for(int i=0; i<QUANTIFY_DIMENSIONS_COUNT; ++i)
-        result.dimensions[i] *= power;
+    {
+        result.set(i, (char) ((signed char) get(i) * power));
+    }
 
     return result;
 }
 
-void Dimensions::copyFrom(const Dimensions &other)
+bool Dimensions::powerOverflows(int power) const
 {
-    setLength(other.getLength());
-    setMass(other.getMass());
-    setTime(other.getTime());
-    setElectricCurrent(other.getElectricCurrent());
-    setThermodynamicTemperature(other.getThermodynamicTemperature());
-    setAmountOfSubstance(other.getAmountOfSubstance());
-    setLuminousIntensity(other.getLuminousIntensity());
-}
+    for(int i=0; i<QUANTIFY_DIMENSIONS_COUNT; ++i)
+    {
+        const long value = (long) (signed char) get(i) * power;
 
-void Dimensions::moveFrom(Dimensions &other)
-{
-    setLength(other.getLength());
-    setMass(other.getMass());
-    setTime(other.getTime());
-    setElectricCurrent(other.getElectricCurrent());
-    setThermodynamicTemperature(other.getThermodynamicTemperature());
-    setAmountOfSubstance(other.getAmountOfSubstance());
-    setLuminousIntensity(other.getLuminousIntensity());
-
-    memset(other.dimensions, 0, QUANTIFY_DIMENSIONS_COUNT);
+        if(value < -128 || value > 127)
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 }
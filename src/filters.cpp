@@ -0,0 +1,122 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/filters.h>
+#include <quantify/converter.h>
+#include <quantify/kernels.h>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+namespace Quantify {
+
+namespace {
+
+bool isEqual(double value, double center)
+{
+    return std::fabs(value - center) < DBL_EPSILON;
+}
+
+// moves a bound to the last double still equal to center (Quantity::equals
+// rule), starting from an estimate within a few ulps
+double equalBound(double estimate, double center, double direction)
+{
+    while(!isEqual(estimate, center))
+        estimate = std::nextafter(estimate, center);
+    while(isEqual(std::nextafter(estimate, direction), center))
+        estimate = std::nextafter(estimate, direction);
+
+    return estimate;
+}
+
+}
+
+// strict bounds become inclusive ones on the next representable double,
+// nothing lies beyond an infinite threshold in its own direction
+Selection Filters::greaterThan(const QuantityArray &column, const Quantity &threshold)
+{
+    const double lower = toColumnUnit(column, threshold);
+    if(lower == std::numeric_limits<double>::infinity())
+        return Selection(column.size());
+
+    return selectRange(column, std::nextafter(lower, std::numeric_limits<double>::infinity()), std::numeric_limits<double>::infinity());
+}
+
+Selection Filters::greaterOrEqual(const QuantityArray &column, const Quantity &threshold)
+{
+    return selectRange(column, toColumnUnit(column, threshold), std::numeric_limits<double>::infinity());
+}
+
+Selection Filters::lessThan(const QuantityArray &column, const Quantity &threshold)
+{
+    const double upper = toColumnUnit(column, threshold);
+    if(upper == -std::numeric_limits<double>::infinity())
+        return Selection(column.size());
+
+    return selectRange(column, -std::numeric_limits<double>::infinity(), std::nextafter(upper, -std::numeric_limits<double>::infinity()));
+}
+
+Selection Filters::lessOrEqual(const QuantityArray &column, const Quantity &threshold)
+{
+    return selectRange(column, -std::numeric_limits<double>::infinity(), toColumnUnit(column, threshold));
+}
+
+Selection Filters::between(const QuantityArray &column, const Quantity &lower, const Quantity &upper)
+{
+    return selectRange(column, toColumnUnit(column, lower), toColumnUnit(column, upper));
+}
+
+Selection Filters::equals(const QuantityArray &column, const Quantity &value, const Quantity &tolerance)
+{
+    const double center = toColumnUnit(column, value);
+    const double margin = std::fabs(Converter(tolerance.getUnit(), column.getUnit()).getScale() * tolerance.getValue());
+
+    return selectRange(column, center - margin, center + margin);
+}
+
+Selection Filters::equals(const QuantityArray &column, const Quantity &value)
+{
+    const double center = toColumnUnit(column, value);
+
+    if(!std::isfinite(center))
+        return Selection(column.size());
+
+    return selectRange(column, equalBound(center - DBL_EPSILON, center, -std::numeric_limits<double>::infinity()),
+                       equalBound(center + DBL_EPSILON, center, std::numeric_limits<double>::infinity()));
+}
+
+double Filters::toColumnUnit(const QuantityArray &column, const Quantity &quantity)
+{
+    return Converter(quantity.getUnit(), column.getUnit()).convert(quantity.getValue());
+}
+
+Selection Filters::selectRange(const QuantityArray &column, double lower, double upper)
+{
+    Selection selection(column.size());
+    Kernels::selectRange(column.data(), column.size(), lower, upper, selection.data());
+
+    return selection;
+}
+
+}
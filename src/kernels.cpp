@@ -0,0 +1,300 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/kernels.h>
+#include <atomic>
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define QUANTIFY_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define QUANTIFY_X86_KERNELS 0
+#endif
+
+namespace Quantify {
+
+namespace {
+
+void affineScalar(const double *input, double *output, std::size_t count, double scale, double bias)
+{
+    for(std::size_t i=0; i<count; ++i)
+        output[i] = input[i] * scale + bias;
+}
+
+std::uint64_t selectWordScalar(const double *values, std::size_t count, double lower, double upper)
+{
+    std::uint64_t word = 0;
+    for(std::size_t i=0; i<count; ++i)
+        word |= (std::uint64_t) (values[i] >= lower && values[i] <= upper) << i;
+
+    return word;
+}
+
+void selectRangeScalar(const double *values, std::size_t count, double lower, double upper, std::uint64_t *bitmap)
+{
+    for(std::size_t i=0; i<count; i+=64)
+        bitmap[i / 64] = selectWordScalar(values + i, (count - i) < 64 ? (count - i) : 64, lower, upper);
+}
+
+#if QUANTIFY_X86_KERNELS
+
+__attribute__((target("sse2")))
+void affineSSE2(const double *input, double *output, std::size_t count, double scale, double bias)
+{
+    const __m128d scales = _mm_set1_pd(scale);
+    const __m128d biases = _mm_set1_pd(bias);
+    std::size_t i = 0;
+
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128d a = _mm_loadu_pd(input + i);
+        __m128d b = _mm_loadu_pd(input + i + 2);
+        _mm_storeu_pd(output + i, _mm_add_pd(_mm_mul_pd(a, scales), biases));
+        _mm_storeu_pd(output + i + 2, _mm_add_pd(_mm_mul_pd(b, scales), biases));
+    }
+
+    affineScalar(input + i, output + i, count - i, scale, bias);
+}
+
+__attribute__((target("avx2,fma")))
+void affineAVX2(const double *input, double *output, std::size_t count, double scale, double bias)
+{
+    const __m256d scales = _mm256_set1_pd(scale);
+    const __m256d biases = _mm256_set1_pd(bias);
+    std::size_t i = 0;
+
+    for(; i + 8 <= count; i += 8)
+    {
+        __m256d a = _mm256_loadu_pd(input + i);
+        __m256d b = _mm256_loadu_pd(input + i + 4);
+        _mm256_storeu_pd(output + i, _mm256_fmadd_pd(a, scales, biases));
+        _mm256_storeu_pd(output + i + 4, _mm256_fmadd_pd(b, scales, biases));
+    }
+
+    for(; i < count; ++i)
+        output[i] = std::fma(input[i], scale, bias);
+}
+
+__attribute__((target("avx512f")))
+void affineAVX512(const double *input, double *output, std::size_t count, double scale, double bias)
+{
+    const __m512d scales = _mm512_set1_pd(scale);
+    const __m512d biases = _mm512_set1_pd(bias);
+    std::size_t i = 0;
+
+    for(; i + 16 <= count; i += 16)
+    {
+        __m512d a = _mm512_loadu_pd(input + i);
+        __m512d b = _mm512_loadu_pd(input + i + 8);
+        _mm512_storeu_pd(output + i, _mm512_fmadd_pd(a, scales, biases));
+        _mm512_storeu_pd(output + i + 8, _mm512_fmadd_pd(b, scales, biases));
+    }
+
+    if(i < count)
+    {
+        const __mmask8 first = (__mmask8) ((1u << ((count - i) < 8 ? (count - i) : 8)) - 1);
+        _mm512_mask_storeu_pd(output + i, first, _mm512_fmadd_pd(_mm512_maskz_loadu_pd(first, input + i), scales, biases));
+        i += 8;
+    }
+
+    if(i < count)
+    {
+        const __mmask8 second = (__mmask8) ((1u << (count - i)) - 1);
+        _mm512_mask_storeu_pd(output + i, second, _mm512_fmadd_pd(_mm512_maskz_loadu_pd(second, input + i), scales, biases));
+    }
+}
+
+__attribute__((target("sse2")))
+void selectRangeSSE2(const double *values, std::size_t count, double lower, double upper, std::uint64_t *bitmap)
+{
+    const __m128d lowers = _mm_set1_pd(lower);
+    const __m128d uppers = _mm_set1_pd(upper);
+    std::size_t i = 0;
+
+    for(; i + 64 <= count; i += 64)
+    {
+        std::uint64_t word = 0;
+        for(int j=0; j<64; j+=2)
+        {
+            const __m128d v = _mm_loadu_pd(values + i + j);
+            word |= (std::uint64_t) _mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(v, lowers), _mm_cmple_pd(v, uppers))) << j;
+        }
+        bitmap[i / 64] = word;
+    }
+
+    if(i < count)
+        bitmap[i / 64] = selectWordScalar(values + i, count - i, lower, upper);
+}
+
+__attribute__((target("avx2")))
+void selectRangeAVX2(const double *values, std::size_t count, double lower, double upper, std::uint64_t *bitmap)
+{
+    const __m256d lowers = _mm256_set1_pd(lower);
+    const __m256d uppers = _mm256_set1_pd(upper);
+    std::size_t i = 0;
+
+    for(; i + 64 <= count; i += 64)
+    {
+        std::uint64_t word = 0;
+        for(int j=0; j<64; j+=4)
+        {
+            const __m256d v = _mm256_loadu_pd(values + i + j);
+            const __m256d selected = _mm256_and_pd(_mm256_cmp_pd(v, lowers, _CMP_GE_OQ), _mm256_cmp_pd(v, uppers, _CMP_LE_OQ));
+            word |= (std::uint64_t) _mm256_movemask_pd(selected) << j;
+        }
+        bitmap[i / 64] = word;
+    }
+
+    if(i < count)
+        bitmap[i / 64] = selectWordScalar(values + i, count - i, lower, upper);
+}
+
+__attribute__((target("avx512f")))
+void selectRangeAVX512(const double *values, std::size_t count, double lower, double upper, std::uint64_t *bitmap)
+{
+    const __m512d lowers = _mm512_set1_pd(lower);
+    const __m512d uppers = _mm512_set1_pd(upper);
+    std::size_t i = 0;
+
+    for(; i + 64 <= count; i += 64)
+    {
+        std::uint64_t word = 0;
+        for(int j=0; j<64; j+=8)
+        {
+            const __m512d v = _mm512_loadu_pd(values + i + j);
+            word |= (std::uint64_t) _mm512_mask_cmp_pd_mask(_mm512_cmp_pd_mask(v, lowers, _CMP_GE_OQ), v, uppers, _CMP_LE_OQ) << j;
+        }
+        bitmap[i / 64] = word;
+    }
+
+    if(i < count)
+        bitmap[i / 64] = selectWordScalar(values + i, count - i, lower, upper);
+}
+
+#endif
+
+Kernels::InstructionSet detectInstructionSet()
+{
+#if QUANTIFY_X86_KERNELS
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512f"))
+        return Kernels::InstructionSet::AVX512;
+
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return Kernels::InstructionSet::AVX2;
+
+    if(__builtin_cpu_supports("sse2"))
+        return Kernels::InstructionSet::SSE2;
+#endif
+
+    return Kernels::InstructionSet::Scalar;
+}
+
+std::atomic<int> &selectedInstructionSet()
+{
+    static std::atomic<int> instructionSet((int) detectInstructionSet());
+    return instructionSet;
+}
+
+}
+
+Kernels::InstructionSet Kernels::getInstructionSet()
+{
+    return (InstructionSet) selectedInstructionSet().load(std::memory_order_relaxed);
+}
+
+Kernels::InstructionSet Kernels::getSupportedInstructionSet()
+{
+    static const InstructionSet supported = detectInstructionSet();
+    return supported;
+}
+
+void Kernels::setInstructionSet(InstructionSet value)
+{
+    if((int) value > (int) getSupportedInstructionSet())
+        value = getSupportedInstructionSet();
+
+    selectedInstructionSet().store((int) value, std::memory_order_relaxed);
+}
+
+const char *Kernels::getInstructionSetName(InstructionSet value)
+{
+    switch(value)
+    {
+    case InstructionSet::SSE2:
+        return "SSE2";
+    case InstructionSet::AVX2:
+        return "AVX2";
+    case InstructionSet::AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+void Kernels::affine(const double *input, double *output, std::size_t count, double scale, double bias)
+{
+    switch(getInstructionSet())
+    {
+#if QUANTIFY_X86_KERNELS
+    case InstructionSet::AVX512:
+        affineAVX512(input, output, count, scale, bias);
+        break;
+    case InstructionSet::AVX2:
+        affineAVX2(input, output, count, scale, bias);
+        break;
+    case InstructionSet::SSE2:
+        affineSSE2(input, output, count, scale, bias);
+        break;
+#endif
+    default:
+        affineScalar(input, output, count, scale, bias);
+        break;
+    }
+}
+
+void Kernels::selectRange(const double *values, std::size_t count, double lower, double upper, std::uint64_t *bitmap)
+{
+    switch(getInstructionSet())
+    {
+#if QUANTIFY_X86_KERNELS
+    case InstructionSet::AVX512:
+        selectRangeAVX512(values, count, lower, upper, bitmap);
+        break;
+    case InstructionSet::AVX2:
+        selectRangeAVX2(values, count, lower, upper, bitmap);
+        break;
+    case InstructionSet::SSE2:
+        selectRangeSSE2(values, count, lower, upper, bitmap);
+        break;
+#endif
+    default:
+        selectRangeScalar(values, count, lower, upper, bitmap);
+        break;
+    }
+}
+
+}
@@ -0,0 +1,69 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/normalizedquantity.h>
+#include <quantify/incompatibleunitsexception.h>
+
+namespace Quantify {
+
+NormalizedQuantity::NormalizedQuantity(const Quantity &quantity)
+    : quantity(quantity), normalizedValue(normalize(quantity.getUnit(), quantity.getValue()))
+{
+
+}
+
+NormalizedQuantity::NormalizedQuantity(Unit unit, double value)
+    : quantity(std::move(unit), value), normalizedValue(normalize(quantity.getUnit(), value))
+{
+
+}
+
+double NormalizedQuantity::normalize(const Unit &unit, double value)
+{
+    const Rational &exactFactor = unit.getExactFactor();
+    const double scaled = exactFactor.isValid() ? exactFactor.scale(value) : unit.getFactor() * value;
+
+    return scaled + unit.getOffset();
+}
+
+Ordering NormalizedQuantity::compare(const NormalizedQuantity &other) const
+{
+    assertCompatibility(other);
+
+    if(normalizedValue == other.normalizedValue)
+        return Ordering::Equal;
+    if(normalizedValue < other.normalizedValue)
+        return Ordering::Less;
+    if(normalizedValue > other.normalizedValue)
+        return Ordering::Greater;
+
+    return Ordering::Unordered;
+}
+
+void NormalizedQuantity::throwIncompatibleUnits(const NormalizedQuantity &other) const
+{
+    throw IncompatibleUnitsException(getUnit(), other.getUnit());
+}
+
+}
@@ -0,0 +1,394 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/quantilesketch.h>
+#include <quantify/converter.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/quantilesketchformatexception.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#define QUANTIFY_QUANTILE_SKETCH_FORMAT_VERSION 1
+#define QUANTIFY_QUANTILE_SKETCH_PI 3.14159265358979323846
+
+namespace Quantify {
+
+namespace {
+
+void writeFixed(std::string &data, std::uint64_t value)
+{
+    for(int i=0; i<8; ++i)
+        data.push_back((char) ((value >> (8 * i)) & 0xFF));
+}
+
+void writeDouble(std::string &data, double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeFixed(data, bits);
+}
+
+void writeVarint(std::string &data, std::uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        data.push_back((char) ((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    data.push_back((char) value);
+}
+
+class Reader
+{
+public:
+    Reader(const std::string &data) : data(data), position(0) {}
+
+    std::uint8_t readByte()
+    {
+        if(position >= data.size())
+            throw QuantileSketchFormatException("unexpected end of data");
+
+        return (std::uint8_t) data[position++];
+    }
+
+    std::uint64_t readFixed()
+    {
+        std::uint64_t value = 0;
+        for(int i=0; i<8; ++i)
+            value |= ((std::uint64_t) readByte()) << (8 * i);
+
+        return value;
+    }
+
+    double readDouble()
+    {
+        const std::uint64_t bits = readFixed();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+
+        return value;
+    }
+
+    std::uint64_t readVarint()
+    {
+        std::uint64_t value = 0;
+        for(int shift=0; shift<64; shift+=7)
+        {
+            const std::uint8_t byte = readByte();
+            value |= ((std::uint64_t) (byte & 0x7F)) << shift;
+            if((byte & 0x80) == 0)
+                return value;
+        }
+
+        throw QuantileSketchFormatException("invalid variable length integer");
+    }
+
+    bool atEnd() const { return position == data.size(); }
+
+private:
+    const std::string &data;
+    std::size_t position;
+};
+
+// checked before the buffer size is derived from it, NaN fails both bounds
+double validCompression(double compression)
+{
+    if(!(compression >= 1.0 && compression <= 1e6))
+        throw std::invalid_argument("QuantileSketch compression must be between 1 and 1e6.");
+
+    return compression;
+}
+
+}
+
+QuantileSketch::QuantileSketch(const Unit &unit, double compression)
+    : unit(unit), canonicalUnit(Unit::fromDimensions(unit.getDimensions())), compression(validCompression(compression))
+    , bufferSize((std::size_t) (QUANTIFY_QUANTILE_SKETCH_BUFFER_FACTOR * this->compression)), converters(canonicalUnit)
+{
+    buffer.reserve(bufferSize);
+    clear();
+}
+
+void QuantileSketch::add(const Quantity *quantities, std::size_t count)
+{
+    for(std::size_t i=0; i<count; ++i)
+        add(quantities[i]);
+}
+
+void QuantileSketch::add(const QuantityArray &array)
+{
+    const Converter converter(array.getUnit(), canonicalUnit);
+
+    for(double value : array)
+    {
+        buffer.push_back(converter.convert(value));
+        if(buffer.size() == bufferSize)
+            flush();
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch &other)
+{
+    if(unit.getDimensions() != other.unit.getDimensions())
+        throw IncompatibleUnitsException(unit, other.unit);
+
+    flush();
+    other.flush();
+    if(other.count == 0)
+        return;
+
+    merged.clear();
+    std::merge(centroids.begin(), centroids.end(), other.centroids.begin(), other.centroids.end(), std::back_inserter(merged),
+               [](const Centroid &left, const Centroid &right) { return left.mean < right.mean; });
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+
+    compress();
+}
+
+void QuantileSketch::clear()
+{
+    centroids.clear();
+    buffer.clear();
+    count = 0;
+    min = std::numeric_limits<double>::infinity();
+    max = -std::numeric_limits<double>::infinity();
+}
+
+Quantity QuantileSketch::quantile(double q, const Unit &unit) const
+{
+    flush();
+
+    const Converter converter(canonicalUnit, unit);
+    if(count == 0 || std::isnan(q))
+        return Quantity(unit, std::numeric_limits<double>::quiet_NaN());
+
+    return Quantity(unit, converter.convert(interpolate(q)));
+}
+
+std::uint64_t QuantileSketch::getCount() const
+{
+    flush();
+    return count;
+}
+
+Quantity QuantileSketch::getMin() const
+{
+    return quantile(0.0);
+}
+
+Quantity QuantileSketch::getMax() const
+{
+    return quantile(1.0);
+}
+
+std::size_t QuantileSketch::getCentroidCount() const
+{
+    flush();
+    return centroids.size();
+}
+
+std::string QuantileSketch::serialize() const
+{
+    flush();
+
+    std::string data;
+    data.reserve(48 + 10 * centroids.size());
+    data.push_back((char) QUANTIFY_QUANTILE_SKETCH_FORMAT_VERSION);
+    writeFixed(data, unit.getDimensions().getPacked());
+    writeDouble(data, compression);
+    writeDouble(data, min);
+    writeDouble(data, max);
+    writeVarint(data, centroids.size());
+    for(const Centroid &centroid : centroids)
+    {
+        writeDouble(data, centroid.mean);
+        writeVarint(data, centroid.weight);
+    }
+
+    return data;
+}
+
+QuantileSketch QuantileSketch::deserialize(const std::string &data, const Unit &unit)
+{
+    Reader reader(data);
+    if(reader.readByte() != QUANTIFY_QUANTILE_SKETCH_FORMAT_VERSION)
+        throw QuantileSketchFormatException("unsupported format version");
+
+    const Dimensions dimensions = Dimensions::fromPacked(reader.readFixed());
+    if(dimensions != unit.getDimensions())
+        throw IncompatibleUnitsException(Unit::fromDimensions(dimensions), unit);
+
+    const double compression = reader.readDouble();
+    if(!(compression >= 1.0 && compression <= 1e6))
+        throw QuantileSketchFormatException("invalid compression");
+
+    QuantileSketch sketch(unit, compression);
+    sketch.min = reader.readDouble();
+    sketch.max = reader.readDouble();
+
+    // every centroid takes at least 9 bytes, bounding the allocation
+    const std::uint64_t size = reader.readVarint();
+    if(size > data.size() / 9)
+        throw QuantileSketchFormatException("invalid centroid count");
+    if(size > 0 && !(std::isfinite(sketch.min) && std::isfinite(sketch.max) && sketch.min <= sketch.max))
+        throw QuantileSketchFormatException("invalid range");
+
+    sketch.centroids.reserve(size);
+    for(std::uint64_t i=0; i<size; ++i)
+    {
+        Centroid centroid;
+        centroid.mean = reader.readDouble();
+        centroid.weight = reader.readVarint();
+
+        if(!std::isfinite(centroid.mean) || centroid.weight == 0 || (i > 0 && centroid.mean < sketch.centroids.back().mean))
+            throw QuantileSketchFormatException("invalid centroid");
+        if(centroid.mean < sketch.min || centroid.mean > sketch.max)
+            throw QuantileSketchFormatException("centroid out of range");
+
+        sketch.centroids.push_back(centroid);
+        sketch.count += centroid.weight;
+    }
+
+    if(!reader.atEnd())
+        throw QuantileSketchFormatException("trailing data");
+    if(size == 0)
+        sketch.clear();
+
+    return sketch;
+}
+
+void QuantileSketch::flush() const
+{
+    if(buffer.empty())
+        return;
+
+    // infinite means would turn into NaN when centroids are merged
+    buffer.erase(std::remove_if(buffer.begin(), buffer.end(), [](double value) { return !std::isfinite(value); }), buffer.end());
+    std::sort(buffer.begin(), buffer.end());
+
+    merged.clear();
+    std::vector<Centroid>::iterator centroid = centroids.begin();
+    for(double value : buffer)
+    {
+        for(; centroid != centroids.end() && centroid->mean < value; ++centroid)
+            merged.push_back(*centroid);
+
+        const Centroid single = {value, 1};
+        merged.push_back(single);
+    }
+    merged.insert(merged.end(), centroid, centroids.end());
+
+    if(!buffer.empty())
+    {
+        count += buffer.size();
+        min = std::min(min, buffer.front());
+        max = std::max(max, buffer.back());
+    }
+    buffer.clear();
+
+    compress();
+}
+
+void QuantileSketch::compress() const
+{
+    // greedy pass over the sorted centroids, a centroid may grow while it
+    // spans at most one unit of k(q) = compression / (2 pi) * asin(2q - 1)
+    const double total = (double) count;
+    const double normalizer = compression / (2.0 * QUANTIFY_QUANTILE_SKETCH_PI);
+    auto weightLimit = [&](double weightBefore)
+    {
+        const double k = normalizer * std::asin(2.0 * std::min(1.0, weightBefore / total) - 1.0) + 1.0;
+        if(k >= compression / 4.0)
+            return total;
+
+        return total * (std::sin(k / normalizer) + 1.0) / 2.0;
+    };
+
+    centroids.clear();
+    if(merged.empty())
+        return;
+
+    Centroid current = merged.front();
+    double weightBefore = 0;
+    double limit = weightLimit(weightBefore);
+
+    for(std::size_t i=1; i<merged.size(); ++i)
+    {
+        const Centroid &next = merged[i];
+        const std::uint64_t weight = current.weight + next.weight;
+
+        if(weightBefore + weight <= limit)
+        {
+            current.mean += (next.mean - current.mean) * ((double) next.weight / weight);
+            current.weight = weight;
+        }
+        else
+        {
+            centroids.push_back(current);
+            weightBefore += current.weight;
+            limit = weightLimit(weightBefore);
+            current = next;
+        }
+    }
+    centroids.push_back(current);
+}
+
+double QuantileSketch::interpolate(double q) const
+{
+    if(q <= 0.0)
+        return min;
+    if(q >= 1.0)
+        return max;
+
+    const double index = q * count;
+    const Centroid &first = centroids.front();
+    const Centroid &last = centroids.back();
+
+    // the extreme centroids are interpolated towards the exact min and max
+    if(index < first.weight / 2.0)
+        return min + (first.mean - min) * (index / (first.weight / 2.0));
+
+    double weightBefore = 0;
+    for(std::size_t i=0; i + 1<centroids.size(); ++i)
+    {
+        const double center = weightBefore + centroids[i].weight / 2.0;
+        const double nextCenter = weightBefore + centroids[i].weight + centroids[i + 1].weight / 2.0;
+
+        if(index <= nextCenter)
+            return centroids[i].mean + (centroids[i + 1].mean - centroids[i].mean) * ((index - center) / (nextCenter - center));
+
+        weightBefore += centroids[i].weight;
+    }
+
+    const double lastCenter = count - last.weight / 2.0;
+    return last.mean + (max - last.mean) * ((index - lastCenter) / (last.weight / 2.0));
+}
+
+}
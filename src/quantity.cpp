@@ -23,60 +23,66 @@
  */
 
 #include <quantify/quantity.h>
+#include <quantify/converter.h>
 #include <quantify/utils.h>
 
 namespace Quantify {
 
-Quantity::Quantity(Unit unit, double value) : value(value), unit(unit)
+Quantity::Quantity(Unit unit, double value) : value(value), unit(std::move(unit))
 {
 
 }
 
-Quantity::Quantity(const Quantity &other)
+Quantity Quantity::convertTo(const Unit &unit) const
 {
-    copyFrom(other);
+    this->unit.assertCompatibility(unit);
+
+    return Quantity(unit, (((this->unit.getFactor() * value) + this->unit.getOffset()) - unit.getOffset()) / (unit.getFactor()));
 }
 
-Quantity::Quantity(Quantity &&other)
+void Quantity::convert(const Unit &from, const Unit &to, const double *input, double *output, std::size_t count)
 {
-    moveFrom(other);
+    Converter(from, to).convert(input, output, count);
 }
 
-Quantity &Quantity::operator=(const Quantity &other)
+void Quantity::convert(const Unit &from, const Unit &to, double *values, std::size_t count)
 {
-    if(this != &other)
-    {
-        copyFrom(other);
-    }
-
-    return *this;
+    Converter(from, to).convert(values, count);
 }
 
-Quantity &Quantity::operator=(Quantity &&other)
+int Quantity::toInt() const
 {
-    if(this != &other)
-    {
-        moveFrom(other);
-    }
-
-    return *this;
+    return ((*this) >= 0.0) ? (int) (value + 0.5) : (int) (value - 0.5);
 }
 
-Quantity Quantity::convertTo(const Unit &unit) const
+float Quantity::toFloat() const
 {
-    this->unit.assertCompatibility(unit);
-
-    return Quantity(unit, (((this->unit.getFactor() * value) + this->unit.getOffset()) - unit.getOffset()) / (unit.getFactor()));
+    return (float) value;
 }
 
-int Quantity::toInt() const
+Ordering Quantity::compare(const Quantity &other) const
 {
-    return ((*this) >= 0.0) ? (int) (value + 0.5) : (int) (value - 0.5);
+    if(unit == other.unit)
+    {
+        return compare(other.value);
+    }
+    else
+    {
+        Quantity tmp = other.convertTo(unit);
+        return compare(tmp.value);
+    }
 }
 
-float Quantity::toFloat() const
+Ordering Quantity::compare(double value) const
 {
-    return (float) value;
+    if(equals(value))
+        return Ordering::Equal;
+    if(lessThan(value))
+        return Ordering::Less;
+    if(greaterThan(value))
+        return Ordering::Greater;
+
+    return Ordering::Unordered;
 }
 
 bool Quantity::equals(const Quantity &other) const
@@ -189,38 +195,75 @@ Quantity Quantity::divideBy(double value) const
     return Quantity(unit / value, this->value / value);
 }
 
-double Quantity::getValue() const
+OperationStatus Quantity::tryConvertTo(const Unit &unit, Quantity &result) const
 {
-    return value;
+    if(!this->unit.isCompatibleTo(unit))
+        return OperationStatus::IncompatibleUnits;
+
+    const double converted = (((this->unit.getFactor() * value) + this->unit.getOffset()) - unit.getOffset()) / (unit.getFactor());
+    result.unit = unit;
+    result.value = converted;
+    return OperationStatus::Ok;
 }
 
-void Quantity::setValue(double value)
+OperationStatus Quantity::tryAdd(const Quantity &other, Quantity &result) const
 {
-    this->value = value;
+    if(!unit.isCompatibleTo(other.unit))
+        return OperationStatus::IncompatibleUnits;
+
+    result = add(other);
+    return OperationStatus::Ok;
 }
 
-Unit Quantity::getUnit() const
+OperationStatus Quantity::trySubtract(const Quantity &other, Quantity &result) const
 {
-    return unit;
+    if(!unit.isCompatibleTo(other.unit))
+        return OperationStatus::IncompatibleUnits;
+
+    result = subtract(other);
+    return OperationStatus::Ok;
 }
 
-void Quantity::setUnit(const Unit &value)
+OperationStatus Quantity::tryMultiplyBy(const Quantity &other, Quantity &result) const
 {
-    unit = value;
+    Unit resultUnit;
+    const OperationStatus status = unit.tryMultiplyBy(other.unit, resultUnit);
+    if(status != OperationStatus::Ok)
+        return status;
+
+    result = Quantity(std::move(resultUnit), value * other.value);
+    return OperationStatus::Ok;
+}
+
+OperationStatus Quantity::tryDivideBy(const Quantity &other, Quantity &result) const
+{
+    Unit resultUnit;
+    const OperationStatus status = unit.tryDivideBy(other.unit, resultUnit);
+    if(status != OperationStatus::Ok)
+        return status;
+
+    result = Quantity(std::move(resultUnit), value / other.value);
+    return OperationStatus::Ok;
+}
+
+double Quantity::getValue() const
+{
+    return value;
 }
 
-void Quantity::copyFrom(const Quantity &other)
+void Quantity::setValue(double value)
 {
-    value = other.value;
-    unit = other.unit;
+    this->value = value;
 }
 
-void Quantity::moveFrom(Quantity &other)
+const Unit &Quantity::getUnit() const
 {
-    value = other.value;
-    unit = std::move(other.unit);
+    return unit;
+}
 
-    other.value = 0;
+void Quantity::setUnit(const Unit &value)
+{
+    unit = value;
 }
 
 }
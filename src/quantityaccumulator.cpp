@@ -0,0 +1,208 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/quantityaccumulator.h>
+#include <quantify/converter.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Quantify {
+
+namespace {
+
+void addCompensated(double &sum, double &compensation, double value)
+{
+    const double total = sum + value;
+
+    if(std::fabs(sum) >= std::fabs(value))
+        compensation += (sum - total) + value;
+    else
+        compensation += (value - total) + sum;
+
+    sum = total;
+}
+
+}
+
+QuantityAccumulator::QuantityAccumulator(const Unit &unit)
+    : unit(unit), converters(unit)
+{
+    clear();
+}
+
+void QuantityAccumulator::add(const double *values, std::size_t count)
+{
+    reduce(values, count);
+}
+
+void QuantityAccumulator::reduce(const double *values, std::size_t count) const
+{
+    if(count == 0)
+        return;
+
+    double batchSum = 0;
+    double batchCompensation = 0;
+    double batchMin = std::numeric_limits<double>::infinity();
+    double batchMax = -std::numeric_limits<double>::infinity();
+
+    for(std::size_t i=0; i<count; ++i)
+    {
+        addCompensated(batchSum, batchCompensation, values[i]);
+        if(values[i] < batchMin)
+            batchMin = values[i];
+        if(values[i] > batchMax)
+            batchMax = values[i];
+    }
+
+    // second pass over a batch that is still in cache, more stable than
+    // updating the deviations one value at a time
+    const double batchMean = (batchSum + batchCompensation) / count;
+    double batchSquaredDeviations = 0;
+    for(std::size_t i=0; i<count; ++i)
+        batchSquaredDeviations += (values[i] - batchMean) * (values[i] - batchMean);
+
+    merge(count, batchSum, batchCompensation, batchMean, batchSquaredDeviations, batchMin, batchMax);
+}
+
+void QuantityAccumulator::add(const Quantity *quantities, std::size_t count)
+{
+    for(std::size_t i=0; i<count; ++i)
+        add(converters.convert(quantities[i]));
+}
+
+void QuantityAccumulator::add(const QuantityArray &array)
+{
+    const Converter converter(array.getUnit(), unit);
+    if(converter.isIdentity())
+    {
+        add(array.data(), array.size());
+        return;
+    }
+
+    double buffer[QUANTIFY_QUANTITY_ACCUMULATOR_BUFFER_SIZE];
+    for(std::size_t first=0; first<array.size(); first+=QUANTIFY_QUANTITY_ACCUMULATOR_BUFFER_SIZE)
+    {
+        const std::size_t size = std::min<std::size_t>(QUANTIFY_QUANTITY_ACCUMULATOR_BUFFER_SIZE, array.size() - first);
+        converter.convert(array.data() + first, buffer, size);
+        add(buffer, size);
+    }
+}
+
+void QuantityAccumulator::merge(const QuantityAccumulator &other)
+{
+    other.flush();
+    if(other.count == 0)
+        return;
+
+    if(other.unit == unit)
+    {
+        merge(other.count, other.sum, other.compensation, other.mean, other.squaredDeviations, other.min, other.max);
+        return;
+    }
+
+    const Converter converter(other.unit, unit);
+    const double scale = converter.getScale();
+    const double lower = converter.convert(other.min);
+    const double upper = converter.convert(other.max);
+
+    merge(other.count, scale * (other.sum + other.compensation) + other.count * converter.getBias(), 0.0, converter.convert(other.mean),
+          scale * scale * other.squaredDeviations, std::min(lower, upper), std::max(lower, upper));
+}
+
+void QuantityAccumulator::clear()
+{
+    count = 0;
+    sum = 0;
+    compensation = 0;
+    mean = 0;
+    squaredDeviations = 0;
+    min = std::numeric_limits<double>::infinity();
+    max = -std::numeric_limits<double>::infinity();
+    pendingCount = 0;
+}
+
+Quantity QuantityAccumulator::getSum() const
+{
+    flush();
+    return Quantity(unit, sum + compensation);
+}
+
+Quantity QuantityAccumulator::getMean() const
+{
+    flush();
+    return Quantity(unit, count ? (sum + compensation) / count : std::numeric_limits<double>::quiet_NaN());
+}
+
+Quantity QuantityAccumulator::getMin() const
+{
+    flush();
+    return Quantity(unit, count ? min : std::numeric_limits<double>::quiet_NaN());
+}
+
+Quantity QuantityAccumulator::getMax() const
+{
+    flush();
+    return Quantity(unit, count ? max : std::numeric_limits<double>::quiet_NaN());
+}
+
+Quantity QuantityAccumulator::getVariance() const
+{
+    flush();
+    return Quantity(unit.power(2), count ? squaredDeviations / count : std::numeric_limits<double>::quiet_NaN());
+}
+
+Quantity QuantityAccumulator::getStandardDeviation() const
+{
+    flush();
+    return Quantity(unit, count ? std::sqrt(squaredDeviations / count) : std::numeric_limits<double>::quiet_NaN());
+}
+
+void QuantityAccumulator::flush() const
+{
+    if(pendingCount == 0)
+        return;
+
+    const std::size_t size = pendingCount;
+    pendingCount = 0;
+    reduce(pending, size);
+}
+
+void QuantityAccumulator::merge(std::size_t count, double sum, double compensation, double mean, double squaredDeviations, double min, double max) const
+{
+    const std::size_t total = this->count + count;
+    const double delta = mean - this->mean;
+
+    // Chan et al. pairwise update of the mean and squared deviations
+    this->squaredDeviations += squaredDeviations + delta * delta * ((double) this->count * count / total);
+    this->mean += delta * ((double) count / total);
+    this->count = total;
+
+    addCompensated(this->sum, this->compensation, sum);
+    this->compensation += compensation;
+    this->min = std::min(this->min, min);
+    this->max = std::max(this->max, max);
+}
+
+}
@@ -0,0 +1,235 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/quantityarray.h>
+#include <quantify/batchnormalizer.h>
+#include <quantify/converter.h>
+#include <stdexcept>
+
+namespace Quantify {
+
+QuantityArray::QuantityArray(Unit unit, std::vector<double> values) : unit(std::move(unit)), values(std::move(values))
+{
+
+}
+
+QuantityArray::QuantityArray(Unit unit, std::size_t size, double value) : unit(std::move(unit)), values(size, value)
+{
+
+}
+
+QuantityArray::QuantityArray(Unit unit, const std::vector<Quantity> &quantities) : unit(std::move(unit)), values(quantities.size())
+{
+    BatchNormalizer::normalize(quantities.data(), quantities.size(), this->unit, values.data());
+}
+
+void QuantityArray::reserve(std::size_t capacity)
+{
+    values.reserve(capacity);
+}
+
+void QuantityArray::clear()
+{
+    values.clear();
+}
+
+void QuantityArray::append(double value)
+{
+    values.push_back(value);
+}
+
+void QuantityArray::append(const Quantity &quantity)
+{
+    values.push_back(quantity.convertTo(unit).getValue());
+}
+
+Quantity QuantityArray::at(std::size_t index) const
+{
+    return Quantity(unit, values.at(index));
+}
+
+QuantityArray QuantityArray::convertTo(const Unit &unit) const
+{
+    QuantityArray result(unit, values.size());
+    Converter(this->unit, unit).convert(values.data(), result.values.data(), values.size());
+
+    return result;
+}
+
+std::vector<Quantity> QuantityArray::toQuantities() const
+{
+    std::vector<Quantity> result;
+    result.reserve(values.size());
+
+    for(double value : values)
+        result.push_back(Quantity(unit, value));
+
+    return result;
+}
+
+QuantityArray QuantityArray::add(const QuantityArray &other) const
+{
+    assertSameSize(other);
+
+    const Converter converter(other.unit, unit);
+    const double scale = converter.getScale();
+    const double bias = converter.getBias();
+
+    QuantityArray result(unit, values.size());
+    for(std::size_t i=0; i<values.size(); ++i)
+        result.values[i] = values[i] + (scale * other.values[i] + bias);
+
+    return result;
+}
+
+QuantityArray QuantityArray::add(const Quantity &other) const
+{
+    return add(other.convertTo(unit).getValue());
+}
+
+QuantityArray QuantityArray::add(double value) const
+{
+    QuantityArray result(unit, values.size());
+    for(std::size_t i=0; i<values.size(); ++i)
+        result.values[i] = values[i] + value;
+
+    return result;
+}
+
+QuantityArray QuantityArray::subtract(const QuantityArray &other) const
+{
+    assertSameSize(other);
+
+    const Converter converter(other.unit, unit);
+    const double scale = converter.getScale();
+    const double bias = converter.getBias();
+
+    QuantityArray result(unit, values.size());
+    for(std::size_t i=0; i<values.size(); ++i)
+        result.values[i] = values[i] - (scale * other.values[i] + bias);
+
+    return result;
+}
+
+QuantityArray QuantityArray::subtract(const Quantity &other) const
+{
+    return subtract(other.convertTo(unit).getValue());
+}
+
+QuantityArray QuantityArray::subtract(double value) const
+{
+    return add(-value);
+}
+
+QuantityArray QuantityArray::multiplyBy(const QuantityArray &other) const
+{
+    assertSameSize(other);
+
+    QuantityArray result(unit * other.unit, values.size());
+    for(std::size_t i=0; i<values.size(); ++i)
+        result.values[i] = values[i] * other.values[i];
+
+    return result;
+}
+
+QuantityArray QuantityArray::multiplyBy(const Quantity &other) const
+{
+    const double value = other.getValue();
+
+    QuantityArray result(unit * other.getUnit(), values.size());
+    for(std::size_t i=0; i<values.size(); ++i)
+        result.values[i] = values[i] * value;
+
+    return result;
+}
+
+QuantityArray QuantityArray::multiplyBy(double value) const
+{
+    QuantityArray result(unit, values.size());
+    for(std::size_t i=0; i<values.size(); ++i)
+        result.values[i] = values[i] * value;
+
+    return result;
+}
+
+QuantityArray QuantityArray::divideBy(const QuantityArray &other) const
+{
+    assertSameSize(other);
+
+    QuantityArray result(unit / other.unit, values.size());
+    for(std::size_t i=0; i<values.size(); ++i)
+        result.values[i] = values[i] / other.values[i];
+
+    return result;
+}
+
+QuantityArray QuantityArray::divideBy(const Quantity &other) const
+{
+    const double value = other.getValue();
+
+    QuantityArray result(unit / other.getUnit(), values.size());
+    for(std::size_t i=0; i<values.size(); ++i)
+        result.values[i] = values[i] / value;
+
+    return result;
+}
+
+QuantityArray QuantityArray::divideBy(double value) const
+{
+    QuantityArray result(unit, values.size());
+    for(std::size_t i=0; i<values.size(); ++i)
+        result.values[i] = values[i] / value;
+
+    return result;
+}
+
+const Unit &QuantityArray::getUnit() const
+{
+    return unit;
+}
+
+const std::vector<double> &QuantityArray::getValues() const
+{
+    return values;
+}
+
+void QuantityArray::setUnit(const Unit &value)
+{
+    unit = value;
+}
+
+void QuantityArray::setValues(std::vector<double> value)
+{
+    values = std::move(value);
+}
+
+void QuantityArray::assertSameSize(const QuantityArray &other) const
+{
+    if(values.size() != other.values.size())
+    {
+        throw std::length_error("QuantityArray operands must have the same size.");
+    }
+}
+
+}
@@ -0,0 +1,360 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/quantityparser.h>
+#include <quantify/unitparser.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+
+#define QUANTIFY_QUANTITY_PARSER_SYMBOLS 256
+#define QUANTIFY_QUANTITY_PARSER_MAX_DIGITS 19
+
+namespace Quantify {
+
+namespace {
+
+const double exactPowersOfTen[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Open addressing table from unit text to the parsed unit, failures included
+// so a bad unit repeated on every record is only parsed once. Keys are
+// compared against the caller's bytes, a std::string is only built on a miss.
+class SymbolCache
+{
+public:
+    SymbolCache() : generation(UnitParser::getGeneration()), size(0) {}
+
+    void refresh()
+    {
+        const std::uint32_t current = UnitParser::getGeneration();
+        if(current != generation)
+        {
+            clear();
+            generation = current;
+        }
+    }
+
+    const Unit *find(const char *text, std::size_t length)
+    {
+        const std::uint64_t hash = hashOf(text, length);
+        std::size_t index = (std::size_t) hash & (QUANTIFY_QUANTITY_PARSER_SYMBOLS - 1);
+
+        for(;;)
+        {
+            Entry &entry = entries[index];
+            if(!entry.used)
+                break;
+
+            if(entry.hash == hash && entry.text.size() == length && std::memcmp(entry.text.data(), text, length) == 0)
+                return entry.valid ? &entry.unit : nullptr;
+
+            index = (index + 1) & (QUANTIFY_QUANTITY_PARSER_SYMBOLS - 1);
+        }
+
+        // keep the table at most half full so probes stay short
+        if(size >= QUANTIFY_QUANTITY_PARSER_SYMBOLS / 2)
+        {
+            clear();
+            index = (std::size_t) hash & (QUANTIFY_QUANTITY_PARSER_SYMBOLS - 1);
+        }
+
+        Entry &entry = entries[index];
+        entry.used = true;
+        entry.hash = hash;
+        entry.text.assign(text, length);
+        entry.valid = resolve(entry.text, entry.unit);
+        ++size;
+
+        return entry.valid ? &entry.unit : nullptr;
+    }
+
+private:
+    struct Entry
+    {
+        Entry() : used(false), valid(false), hash(0) {}
+
+        bool used;
+        bool valid;
+        std::uint64_t hash;
+        std::string text;
+        Unit unit;
+    };
+
+    static bool resolve(const std::string &text, Unit &unit)
+    {
+        try
+        {
+            unit = UnitParser::parse(text);
+            return true;
+        }
+        catch(std::exception &)
+        {
+            return false;
+        }
+    }
+
+    static std::uint64_t hashOf(const char *text, std::size_t length)
+    {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for(std::size_t i=0; i<length; ++i)
+        {
+            hash ^= (unsigned char) text[i];
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    void clear()
+    {
+        for(Entry &entry : entries)
+        {
+            entry.used = false;
+            entry.unit = Unit();
+        }
+
+        size = 0;
+    }
+
+    std::uint32_t generation;
+    std::size_t size;
+    Entry entries[QUANTIFY_QUANTITY_PARSER_SYMBOLS];
+};
+
+// thread local access is not free from a shared library, batches look the
+// cache up once
+SymbolCache &symbolCache()
+{
+    static thread_local SymbolCache instance;
+    instance.refresh();
+    return instance;
+}
+
+QuantityParser::Status parseWith(SymbolCache &symbols, const char *text, std::size_t length, Quantity &quantity)
+{
+    const char *cursor = text;
+    const char *end = text + length;
+
+    while(cursor < end && isSpace(*cursor))
+        ++cursor;
+    while(end > cursor && isSpace(end[-1]))
+        --end;
+
+    if(cursor == end)
+        return QuantityParser::Status::Empty;
+
+    double value;
+    if(!QuantityParser::parseNumber(cursor, end, value))
+        return QuantityParser::Status::InvalidNumber;
+
+    const char *unitText = cursor;
+    while(unitText < end && isSpace(*unitText))
+        ++unitText;
+
+    // a unit glued to the number ("12km") is accepted, digits are not
+    if(unitText == cursor && unitText < end && (isDigit(*unitText) || *unitText == '.'))
+        return QuantityParser::Status::InvalidNumber;
+
+    if(unitText < end)
+    {
+        const Unit *unit = symbols.find(unitText, (std::size_t) (end - unitText));
+        if(!unit)
+            return QuantityParser::Status::InvalidUnit;
+
+        quantity.setUnit(*unit);
+    }
+    else
+    {
+        quantity.setUnit(Unit());
+    }
+
+    quantity.setValue(value);
+
+    return QuantityParser::Status::Ok;
+}
+
+}
+
+bool QuantityParser::parseNumber(const char *&text, const char *end, double &value)
+{
+    const char *cursor = text;
+    bool negative = false;
+
+    if(cursor < end && (*cursor == '-' || *cursor == '+'))
+    {
+        negative = *cursor == '-';
+        ++cursor;
+    }
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool seenDigit = false;
+
+    for(; cursor < end && isDigit(*cursor); ++cursor)
+    {
+        seenDigit = true;
+        if(digits < QUANTIFY_QUANTITY_PARSER_MAX_DIGITS)
+        {
+            mantissa = mantissa * 10 + (std::uint64_t) (*cursor - '0');
+            digits += mantissa != 0 ? 1 : 0;
+        }
+        else
+        {
+            ++exponent;
+        }
+    }
+
+    if(cursor < end && *cursor == '.')
+    {
+        ++cursor;
+        for(; cursor < end && isDigit(*cursor); ++cursor)
+        {
+            seenDigit = true;
+            if(digits < QUANTIFY_QUANTITY_PARSER_MAX_DIGITS)
+            {
+                mantissa = mantissa * 10 + (std::uint64_t) (*cursor - '0');
+                digits += mantissa != 0 ? 1 : 0;
+                --exponent;
+            }
+        }
+    }
+
+    if(!seenDigit)
+        return false;
+
+    // the exponent is only consumed when digits follow, "2 e" is not a number
+    if(cursor < end && (*cursor == 'e' || *cursor == 'E'))
+    {
+        const char *exponentCursor = cursor + 1;
+        bool negativeExponent = false;
+        if(exponentCursor < end && (*exponentCursor == '-' || *exponentCursor == '+'))
+        {
+            negativeExponent = *exponentCursor == '-';
+            ++exponentCursor;
+        }
+
+        if(exponentCursor < end && isDigit(*exponentCursor))
+        {
+            int explicitExponent = 0;
+            for(; exponentCursor < end && isDigit(*exponentCursor); ++exponentCursor)
+            {
+                if(explicitExponent < 100000)
+                    explicitExponent = explicitExponent * 10 + (*exponentCursor - '0');
+            }
+
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+            cursor = exponentCursor;
+        }
+    }
+
+    double result;
+    if(mantissa == 0)
+    {
+        result = 0.0;
+    }
+    else if(mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22)
+    {
+        // both operands are exact, so the single operation is correctly rounded
+        result = exponent < 0 ? (double) mantissa / exactPowersOfTen[-exponent] : (double) mantissa * exactPowersOfTen[exponent];
+    }
+    else
+    {
+        result = (double) ((long double) mantissa * std::pow(10.0L, (long double) exponent));
+    }
+
+    value = negative ? -result : result;
+    text = cursor;
+
+    return true;
+}
+
+QuantityParser::Status QuantityParser::parse(const char *text, std::size_t length, Quantity &quantity)
+{
+    return parseWith(symbolCache(), text, length, quantity);
+}
+
+QuantityParser::Status QuantityParser::parse(const std::string &text, Quantity &quantity)
+{
+    return parse(text.data(), text.size(), quantity);
+}
+
+std::size_t QuantityParser::parseLines(const char *buffer, std::size_t length, std::vector<Quantity> &quantities,
+                                       std::vector<Status> &statuses)
+{
+    const char *cursor = buffer;
+    const char *end = buffer + length;
+    std::size_t parsed = 0;
+    SymbolCache &symbols = symbolCache();
+
+    while(cursor < end)
+    {
+        const char *lineEnd = (const char *) std::memchr(cursor, '\n', (std::size_t) (end - cursor));
+        if(!lineEnd)
+            lineEnd = end;
+
+        quantities.emplace_back();
+        const Status status = parseWith(symbols, cursor, (std::size_t) (lineEnd - cursor), quantities.back());
+        statuses.push_back(status);
+        parsed += status == Status::Ok ? 1 : 0;
+
+        cursor = lineEnd + 1;
+    }
+
+    return parsed;
+}
+
+const char *QuantityParser::getStatusName(Status value)
+{
+    switch(value)
+    {
+    case Status::Ok:
+        return "ok";
+    case Status::Empty:
+        return "empty";
+    case Status::InvalidNumber:
+        return "invalid number";
+    case Status::InvalidUnit:
+        return "invalid unit";
+    }
+
+    return "unknown";
+}
+
+}
@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/rational.h>
+#include <cmath>
+#include <limits>
+
+#define QUANTIFY_RATIONAL_MAX_EXPONENT 300
+#define QUANTIFY_RATIONAL_MAX_DECIMALS 17
+// doubles computed rather than written (1.0 / 3.0) need 16 or 17 significant
+// digits to round trip, shorter decimals are taken as exact
+#define QUANTIFY_RATIONAL_MAX_SIGNIFICAND 1e15
+
+namespace Quantify {
+
+namespace {
+
+bool multiplyChecked(std::int64_t left, std::int64_t right, std::int64_t &result)
+{
+    if(left != 0 && std::llabs(right) > std::numeric_limits<std::int64_t>::max() / std::llabs(left))
+        return false;
+
+    result = left * right;
+    return true;
+}
+
+}
+
+Rational Rational::fromDouble(double value)
+{
+    // 2^53, above it the decimal search is pointless since every double is
+    // an integer, and 2^63, the range of the numerator
+    const double exactLimit = 9007199254740992.0;
+    const double numeratorLimit = 9223372036854775808.0;
+
+    if(!std::isfinite(value))
+        return Rational();
+
+    if(std::fabs(value) < exactLimit)
+    {
+        double scale = 1.0;
+        for(int decimals=0; decimals<=QUANTIFY_RATIONAL_MAX_DECIMALS; ++decimals, scale *= 10.0)
+        {
+            const double scaled = std::nearbyint(value * scale);
+            if(std::fabs(scaled) >= (decimals == 0 ? exactLimit : QUANTIFY_RATIONAL_MAX_SIGNIFICAND))
+                break;
+
+            const Rational candidate((std::int64_t) scaled, 1, -decimals);
+            if(candidate.toDouble() == value)
+                return candidate;
+        }
+    }
+    else if(std::fabs(value) < numeratorLimit)
+    {
+        return Rational((std::int64_t) value);
+    }
+
+    return Rational();
+}
+
+double Rational::scale(double value) const
+{
+    const long double scaled = (long double) value * numerator;
+
+    if(exponent >= 0)
+        return (double) (scaled * (long double) pow10(exponent) / denominator);
+
+    return (double) (scaled / ((long double) denominator * (long double) pow10(-exponent)));
+}
+
+Rational Rational::multiplyBy(const Rational &other) const
+{
+    if(!isValid() || !other.isValid())
+        return Rational();
+
+    // cross reduce first, the operands are already reduced on their own
+    const std::int64_t leftGcd = gcd(numerator, other.denominator);
+    const std::int64_t rightGcd = gcd(other.numerator, denominator);
+    const int resultExponent = exponent + other.exponent;
+    std::int64_t resultNumerator;
+    std::int64_t resultDenominator;
+
+    if(!multiplyChecked(numerator / leftGcd, other.numerator / rightGcd, resultNumerator)
+       || !multiplyChecked(denominator / rightGcd, other.denominator / leftGcd, resultDenominator)
+       || std::abs(resultExponent) > QUANTIFY_RATIONAL_MAX_EXPONENT)
+        return Rational();
+
+    return Rational(resultNumerator, resultDenominator, resultExponent);
+}
+
+Rational Rational::divideBy(const Rational &other) const
+{
+    if(!other.isValid() || other.numerator == 0)
+        return Rational();
+
+    return multiplyBy(Rational(other.denominator, other.numerator, -other.exponent));
+}
+
+Rational Rational::power(int power) const
+{
+    const Rational base = (power < 0) ? Rational(1).divideBy(*this) : *this;
+    Rational result(1);
+
+    for(int i=0; i<std::abs(power) && result.isValid(); ++i)
+        result = result.multiplyBy(base);
+
+    return isValid() ? result : Rational();
+}
+
+}
@@ -0,0 +1,269 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/reductions.h>
+#include <quantify/converter.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace Quantify {
+
+namespace {
+
+// Threads shared by every reduction, created on first use and added when a
+// call asks for more helpers than the pool has, up to
+// QUANTIFY_REDUCTIONS_MAX_THREADS. A call queues one task per helper and runs
+// worker 0 itself, tasks no thread picked up by the time it is done are
+// withdrawn, so a busy pool or a thread that cannot be created only costs
+// parallelism. Waits are timed: GCC 12 versions the untimed
+// std::condition_variable::wait as GLIBCXX_3.4.30 while timed waits are
+// inlined, which keeps the library loadable against older libstdc++.
+class WorkerPool
+{
+public:
+    typedef std::function<void(unsigned int worker)> Work;
+
+    static WorkerPool &getInstance()
+    {
+        static WorkerPool instance;
+        return instance;
+    }
+
+    WorkerPool(const WorkerPool &other) = delete;
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        available.notify_all();
+        for(std::thread &thread : threads)
+            thread.join();
+    }
+
+    WorkerPool &operator=(const WorkerPool &other) = delete;
+
+    // runs work(0) on the calling thread and work(1) to work(helpers) on the
+    // pool, returns once every started one is done; work must not throw
+    void run(const Work &work, unsigned int helpers)
+    {
+        Job job(work);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            grow(helpers);
+            try
+            {
+                for(unsigned int worker=1; worker<=helpers; ++worker)
+                {
+                    tasks.push_back(Task(&job, worker));
+                    ++job.pending;
+                }
+            }
+            catch(...)
+            {
+                // the tasks already queued still help
+            }
+        }
+
+        available.notify_all();
+        work(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        withdraw(job);
+        while(!finished.wait_for(lock, std::chrono::seconds(1), [&job]() { return job.pending == 0; }))
+        {
+        }
+    }
+
+private:
+    struct Job
+    {
+        explicit Job(const Work &work) : work(work), pending(0) {}
+
+        const Work &work;
+        unsigned int pending;
+    };
+
+    struct Task
+    {
+        Task(Job *job, unsigned int worker) : job(job), worker(worker) {}
+
+        Job *job;
+        unsigned int worker;
+    };
+
+    WorkerPool() : stopping(false) {}
+
+    // called with the mutex held
+    void grow(unsigned int helpers)
+    {
+        try
+        {
+            while(threads.size() < helpers)
+                threads.emplace_back(&WorkerPool::serve, this);
+        }
+        catch(...)
+        {
+        }
+    }
+
+    // called with the mutex held, removes the tasks of job still queued
+    void withdraw(Job &job)
+    {
+        for(std::deque<Task>::iterator it = tasks.begin(); it != tasks.end();)
+        {
+            if(it->job == &job)
+            {
+                it = tasks.erase(it);
+                --job.pending;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void serve()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for(;;)
+        {
+            while(!available.wait_for(lock, std::chrono::seconds(1), [this]() { return stopping || !tasks.empty(); }))
+            {
+            }
+            if(tasks.empty())
+                return;
+
+            const Task task = tasks.front();
+            tasks.pop_front();
+
+            lock.unlock();
+            task.job->work(task.worker);
+            lock.lock();
+
+            if(--task.job->pending == 0)
+                finished.notify_all();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::condition_variable finished;
+    std::deque<Task> tasks;
+    std::vector<std::thread> threads;
+    bool stopping;
+};
+
+}
+
+Reductions::Summary Reductions::summarize(const Quantity *quantities, std::size_t count, const Unit &unit, unsigned int threads)
+{
+    return reduce(count, unit, threads, [quantities](std::size_t first, std::size_t count, double *, QuantityAccumulator &partial)
+    {
+        partial.add(quantities + first, count);
+    });
+}
+
+Reductions::Summary Reductions::summarize(const std::vector<Quantity> &quantities, const Unit &unit, unsigned int threads)
+{
+    return summarize(quantities.data(), quantities.size(), unit, threads);
+}
+
+Reductions::Summary Reductions::summarize(const QuantityArray &array, const Unit &unit, unsigned int threads)
+{
+    const Converter converter(array.getUnit(), unit);
+    const double *values = array.data();
+
+    return reduce(array.size(), unit, threads, [&converter, values](std::size_t first, std::size_t count, double *buffer, QuantityAccumulator &partial)
+    {
+        if(converter.isIdentity())
+        {
+            partial.add(values + first, count);
+            return;
+        }
+
+        converter.convert(values + first, buffer, count);
+        partial.add(buffer, count);
+    });
+}
+
+Reductions::Summary Reductions::reduce(std::size_t count, const Unit &unit, unsigned int threads, const BlockReducer &reducer)
+{
+    const std::size_t blockCount = (count + QUANTIFY_REDUCTIONS_BLOCK_SIZE - 1) / QUANTIFY_REDUCTIONS_BLOCK_SIZE;
+    std::vector<Summary> partials(blockCount, Summary(unit));
+    std::atomic<std::size_t> nextBlock(0);
+
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    // inputs of a single block are reduced on the calling thread
+    threads = (unsigned int) std::min<std::size_t>(std::min(threads, (unsigned int) QUANTIFY_REDUCTIONS_MAX_THREADS), std::max<std::size_t>(blockCount, 1));
+
+    std::vector<std::exception_ptr> errors(threads);
+    auto work = [&](unsigned int worker)
+    {
+        try
+        {
+            std::vector<double> buffer(QUANTIFY_REDUCTIONS_BLOCK_SIZE);
+
+            for(std::size_t block = nextBlock++; block < blockCount; block = nextBlock++)
+            {
+                const std::size_t first = block * QUANTIFY_REDUCTIONS_BLOCK_SIZE;
+                reducer(first, std::min<std::size_t>(QUANTIFY_REDUCTIONS_BLOCK_SIZE, count - first), buffer.data(), partials[block]);
+            }
+        }
+        catch(...)
+        {
+            errors[worker] = std::current_exception();
+            nextBlock = blockCount;
+        }
+    };
+
+    if(threads > 1)
+        WorkerPool::getInstance().run(work, threads - 1);
+    else
+        work(0);
+
+    for(const std::exception_ptr &error : errors)
+    {
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+    // merged in block order whatever thread reduced each block
+    Summary result(unit);
+    for(const Summary &partial : partials)
+        result.merge(partial);
+
+    return result;
+}
+
+}
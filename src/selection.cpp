@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/selection.h>
+#include <stdexcept>
+
+namespace Quantify {
+
+Selection::Selection(std::size_t size, bool selected)
+    : length(size), words((size + 63) / 64, selected ? ~(std::uint64_t) 0 : 0)
+{
+    clearUnusedBits();
+}
+
+void Selection::setSelected(std::size_t index, bool value)
+{
+    const std::uint64_t bit = (std::uint64_t) 1 << (index % 64);
+
+    if(value)
+        words[index / 64] |= bit;
+    else
+        words[index / 64] &= ~bit;
+}
+
+std::size_t Selection::count() const
+{
+    std::size_t result = 0;
+    for(std::uint64_t word : words)
+        result += (std::size_t) __builtin_popcountll(word);
+
+    return result;
+}
+
+std::vector<std::size_t> Selection::toIndices() const
+{
+    std::vector<std::size_t> indices;
+    indices.reserve(count());
+
+    for(std::size_t i=0; i<words.size(); ++i)
+    {
+        for(std::uint64_t word = words[i]; word != 0; word &= word - 1)
+            indices.push_back(i * 64 + (std::size_t) __builtin_ctzll(word));
+    }
+
+    return indices;
+}
+
+Selection Selection::intersect(const Selection &other) const
+{
+    Selection result = *this;
+    result &= other;
+
+    return result;
+}
+
+Selection Selection::unite(const Selection &other) const
+{
+    Selection result = *this;
+    result |= other;
+
+    return result;
+}
+
+Selection Selection::invert() const
+{
+    Selection result = *this;
+    for(std::uint64_t &word : result.words)
+        word = ~word;
+    result.clearUnusedBits();
+
+    return result;
+}
+
+Selection &Selection::operator&=(const Selection &other)
+{
+    assertSameSize(other);
+
+    for(std::size_t i=0; i<words.size(); ++i)
+        words[i] &= other.words[i];
+
+    return *this;
+}
+
+Selection &Selection::operator|=(const Selection &other)
+{
+    assertSameSize(other);
+
+    for(std::size_t i=0; i<words.size(); ++i)
+        words[i] |= other.words[i];
+
+    return *this;
+}
+
+void Selection::assertSameSize(const Selection &other) const
+{
+    if(length != other.length)
+        throw std::length_error("Selection operands must have the same size.");
+}
+
+void Selection::clearUnusedBits()
+{
+    if(length % 64 != 0)
+        words.back() &= ((std::uint64_t) 1 << (length % 64)) - 1;
+}
+
+}
@@ -24,128 +24,266 @@
 
 #include <quantify/standardunits.h>
 
+// Every standard unit is constant initialized from a static label and body
+// with constexpr dimensions, factor and offset: nothing runs at load time and
+// definitions cannot observe each other half initialized.
+#define QUANTIFY_STANDARD_UNIT(category, unit, name, symbol, ...) \
+    static const UnitLabel category##_##unit##_label(name, symbol); \
+    static const UnitBody category##_##unit##_body(&category##_##unit##_label, __VA_ARGS__); \
+    const Unit category::unit(category##_##unit##_body)
+
 namespace Quantify {
 namespace StandardUnits {
 
+namespace {
+
+constexpr Dimensions lengthDimensions(1);
+constexpr Dimensions massDimensions(0, 1);
+constexpr Dimensions timeDimensions(0, 0, 1);
+constexpr Dimensions temperatureDimensions(0, 0, 0, 0, 1);
+constexpr Dimensions areaDimensions(2);
+constexpr Dimensions volumeDimensions(3);
+constexpr Dimensions speedDimensions(1, 0, -1);
+constexpr Dimensions forceDimensions(1, 1, -2);
+constexpr Dimensions energyDimensions(2, 1, -2);
+constexpr Dimensions powerDimensions(2, 1, -3);
+constexpr Dimensions pressureDimensions(-1, 1, -2);
+constexpr Dimensions frequencyDimensions(0, 0, -1);
+
+// exact factors other units are derived from, Rational arithmetic is not
+// constexpr so derived factors below are expanded by hand
+constexpr Rational thouFactor(254, 1, -7);
+constexpr Rational inchFactor(254, 1, -4);
+constexpr Rational footFactor(3048, 1, -4);
+constexpr Rational yardFactor(9144, 1, -4);
+constexpr Rational chainFactor(201168, 1, -4);
+constexpr Rational furlongFactor(201168, 1, -3);
+constexpr Rational mileFactor(1609344, 1, -3);
+constexpr Rational gramFactor(1, 1, -3);
+constexpr Rational hourFactor(3600);
+constexpr Rational decimeterFactor(1, 1, -1);
+constexpr Rational literFactor(1, 1, -3);
+constexpr Rational kilometerPerHourFactor(1000, 3600);
+constexpr Rational poundForceFactor(44482216152605, 1, -13);
+constexpr Rational wattHourFactor = hourFactor;
+constexpr Rational calorieFactor(41868, 1, -4);
+constexpr Rational barFactor(1, 1, 5);
+
+}
+
 // Length units
 
 // metric
-const Unit LengthUnits::meter("meter", "m", Dimensions(1));
-const Unit LengthUnits::millimeter("millimeter", "mm", 0.001 * LengthUnits::meter);
-const Unit LengthUnits::centimeter("centimeter", "cm", 0.01 * LengthUnits::meter);
-const Unit LengthUnits::decimeter("decimeter", "dm", 0.1 * LengthUnits::meter);
-const Unit LengthUnits::decameter("decameter", "Dm", 10.0 * LengthUnits::meter);
-const Unit LengthUnits::hectometer("hectometer", "Hm", 100.0 * LengthUnits::meter);
-const Unit LengthUnits::kilometer("kilometer", "km", 1000.0 * LengthUnits::meter);
+QUANTIFY_STANDARD_UNIT(LengthUnits, meter, "meter", "m", lengthDimensions);
+QUANTIFY_STANDARD_UNIT(LengthUnits, millimeter, "millimeter", "mm", lengthDimensions, Rational(1, 1, -3));
+QUANTIFY_STANDARD_UNIT(LengthUnits, centimeter, "centimeter", "cm", lengthDimensions, Rational(1, 1, -2));
+QUANTIFY_STANDARD_UNIT(LengthUnits, decimeter, "decimeter", "dm", lengthDimensions, decimeterFactor);
+QUANTIFY_STANDARD_UNIT(LengthUnits, decameter, "decameter", "Dm", lengthDimensions, Rational(10));
+QUANTIFY_STANDARD_UNIT(LengthUnits, hectometer, "hectometer", "Hm", lengthDimensions, Rational(100));
+QUANTIFY_STANDARD_UNIT(LengthUnits, kilometer, "kilometer", "km", lengthDimensions, Rational(1000));
 
 // imperial units
-const Unit LengthUnits::thou("thou", "th", 0.0000254 * LengthUnits::meter);
-const Unit LengthUnits::inch("inch", "in", 1000.0 * LengthUnits::thou);
-const Unit LengthUnits::foot("foot", "ft", 12.0 * LengthUnits::inch);
-const Unit LengthUnits::yard("yard", "yd", 3.0 * LengthUnits::foot);
-const Unit LengthUnits::chain("chain", "ch", 22.0 * LengthUnits::yard);
-const Unit LengthUnits::furlong("furlong", "fur", 10.0 * LengthUnits::chain);
-const Unit LengthUnits::mile("mile", "mi", 8.0 * LengthUnits::furlong);
+QUANTIFY_STANDARD_UNIT(LengthUnits, thou, "thou", "th", lengthDimensions, thouFactor);
+QUANTIFY_STANDARD_UNIT(LengthUnits, inch, "inch", "in", lengthDimensions, inchFactor);
+QUANTIFY_STANDARD_UNIT(LengthUnits, foot, "foot", "ft", lengthDimensions, footFactor);
+QUANTIFY_STANDARD_UNIT(LengthUnits, yard, "yard", "yd", lengthDimensions, yardFactor);
+QUANTIFY_STANDARD_UNIT(LengthUnits, chain, "chain", "ch", lengthDimensions, chainFactor);
+QUANTIFY_STANDARD_UNIT(LengthUnits, furlong, "furlong", "fur", lengthDimensions, furlongFactor);
+QUANTIFY_STANDARD_UNIT(LengthUnits, mile, "mile", "mi", lengthDimensions, mileFactor);
 
-const Unit LengthUnits::nauticalMile("nautical mile", "nmi", 1852.0 * LengthUnits::meter);
+QUANTIFY_STANDARD_UNIT(LengthUnits, nauticalMile, "nautical mile", "nmi", lengthDimensions, Rational(1852));
 
-const Unit LengthUnits::lightYear("light-year", "ly", 9460730472580800.0 * LengthUnits::meter);
+QUANTIFY_STANDARD_UNIT(LengthUnits, lightYear, "light-year", "ly", lengthDimensions, Rational(9460730472580800));
 
 // Mass units
-const Unit MassUnits::kilogram("kilogram", "kg", Dimensions(0, 1));
-const Unit MassUnits::gram("gram", "g", 0.001 * MassUnits::kilogram);
-const Unit MassUnits::milligram("milligram", "mg", 0.001 * MassUnits::gram);
-const Unit MassUnits::ton("ton", "ton", 1000.0 * MassUnits::kilogram);
+QUANTIFY_STANDARD_UNIT(MassUnits, kilogram, "kilogram", "kg", massDimensions);
+QUANTIFY_STANDARD_UNIT(MassUnits, gram, "gram", "g", massDimensions, gramFactor);
+QUANTIFY_STANDARD_UNIT(MassUnits, milligram, "milligram", "mg", massDimensions, Rational(1, 1, -6));
+QUANTIFY_STANDARD_UNIT(MassUnits, ton, "ton", "ton", massDimensions, Rational(1000));
 
-const Unit MassUnits::ounce("ounce", "oz", 28 * MassUnits::gram);
-const Unit MassUnits::pound("pound", "lb", 0.5 * MassUnits::kilogram);
+QUANTIFY_STANDARD_UNIT(MassUnits, ounce, "ounce", "oz", massDimensions, Rational(28, 1, -3));
+QUANTIFY_STANDARD_UNIT(MassUnits, pound, "pound", "lb", massDimensions, Rational(5, 1, -1));
 
 // Time units
-const Unit TimeUnits::second("second", "s", Dimensions(0, 0, 1));
-const Unit TimeUnits::microsecond("microsecond", "μs", 0.000001 * TimeUnits::second);
-const Unit TimeUnits::millisecond("millisecond", "ms", 0.001 * TimeUnits::second);
-const Unit TimeUnits::minute("minute", "min", 60.0 * TimeUnits::second);
-const Unit TimeUnits::hour("hour", "h", 3600.0 * TimeUnits::second);
-const Unit TimeUnits::day("day", "d", 24.0 * TimeUnits::hour);
+QUANTIFY_STANDARD_UNIT(TimeUnits, second, "second", "s", timeDimensions);
+QUANTIFY_STANDARD_UNIT(TimeUnits, microsecond, "microsecond", "μs", timeDimensions, Rational(1, 1, -6));
+QUANTIFY_STANDARD_UNIT(TimeUnits, millisecond, "millisecond", "ms", timeDimensions, Rational(1, 1, -3));
+QUANTIFY_STANDARD_UNIT(TimeUnits, minute, "minute", "min", timeDimensions, Rational(60));
+QUANTIFY_STANDARD_UNIT(TimeUnits, hour, "hour", "h", timeDimensions, hourFactor);
+QUANTIFY_STANDARD_UNIT(TimeUnits, day, "day", "d", timeDimensions, Rational(24 * 3600));
 
 // Electric units
-const Unit ElectricUnits::ampere("ampere", "A", Dimensions(0, 0, 0, 1));
-const Unit ElectricUnits::coulomb("coulomb", "C", TimeUnits::second * ElectricUnits::ampere);
-const Unit ElectricUnits::volt("volt", "V", EnergyUnits::watt * ElectricUnits::ampere.power(-1));
-const Unit ElectricUnits::ohm("ohm", "Ω", ElectricUnits::volt * ElectricUnits::ampere.power(-1));
-const Unit ElectricUnits::farad("farad", "F", ElectricUnits::coulomb * ElectricUnits::volt.power(-1));
+QUANTIFY_STANDARD_UNIT(ElectricUnits, ampere, "ampere", "A", Dimensions(0, 0, 0, 1));
+QUANTIFY_STANDARD_UNIT(ElectricUnits, coulomb, "coulomb", "C", Dimensions(0, 0, 1, 1));
+QUANTIFY_STANDARD_UNIT(ElectricUnits, volt, "volt", "V", Dimensions(2, 1, -3, -1));
+QUANTIFY_STANDARD_UNIT(ElectricUnits, ohm, "ohm", "Ω", Dimensions(2, 1, -3, -2));
+QUANTIFY_STANDARD_UNIT(ElectricUnits, farad, "farad", "F", Dimensions(-2, -1, 4, 2));
 
 // Temperature units
-const Unit TemperatureUnits::kelvin("kelvin", "K", Dimensions(0, 0, 0, 0, 1));
-const Unit TemperatureUnits::degreeCelsius("degree Celsius", "°C", TemperatureUnits::kelvin + 273.15);
-const Unit TemperatureUnits::degreeFahrenheit("degree Fahrenheit", "°F", ((5.0/9.0) * TemperatureUnits::kelvin) + ((5.0/9.0) * 459.67));
+QUANTIFY_STANDARD_UNIT(TemperatureUnits, kelvin, "kelvin", "K", temperatureDimensions);
+QUANTIFY_STANDARD_UNIT(TemperatureUnits, degreeCelsius, "degree Celsius", "°C", temperatureDimensions, Rational(1), 273.15);
+QUANTIFY_STANDARD_UNIT(TemperatureUnits, degreeFahrenheit, "degree Fahrenheit", "°F", temperatureDimensions, Rational(5, 9), (5.0 / 9.0) * 459.67);
 
 // Amount of substance units
-const Unit AmountOfSubstanceUnits::mole("mole", "mol", Dimensions(0, 0, 0, 0, 0, 1));
+QUANTIFY_STANDARD_UNIT(AmountOfSubstanceUnits, mole, "mole", "mol", Dimensions(0, 0, 0, 0, 0, 1));
 
 // Luminous intensity units
-const Unit LuminousIntensityUnits::candela("candela", "cd", Dimensions(0, 0, 0, 0, 0, 0, 1));
+QUANTIFY_STANDARD_UNIT(LuminousIntensityUnits, candela, "candela", "cd", Dimensions(0, 0, 0, 0, 0, 0, 1));
 
 // Area units
-const Unit AreaUnits::meter2("meter^2", "m^2", LengthUnits::meter.power(2));
-const Unit AreaUnits::are("are", "are", 100.0 * AreaUnits::meter2);
-const Unit AreaUnits::hectare("hectare", "ha", 10000.0 * AreaUnits::meter2);
-const Unit AreaUnits::kilometer2("kilometer^2", "Km^2", LengthUnits::kilometer.power(2));
-const Unit AreaUnits::inch2("inch^2", "in^2", LengthUnits::inch.power(2));
+QUANTIFY_STANDARD_UNIT(AreaUnits, meter2, "meter^2", "m^2", areaDimensions);
+QUANTIFY_STANDARD_UNIT(AreaUnits, are, "are", "are", areaDimensions, Rational(100));
+QUANTIFY_STANDARD_UNIT(AreaUnits, hectare, "hectare", "ha", areaDimensions, Rational(10000));
+QUANTIFY_STANDARD_UNIT(AreaUnits, kilometer2, "kilometer^2", "Km^2", areaDimensions, Rational(1000 * 1000));
+QUANTIFY_STANDARD_UNIT(AreaUnits, inch2, "inch^2", "in^2", areaDimensions, Rational(254 * 254, 1, -8));
 
 // Volume units
-const Unit VolumeUnits::liter("liter", "L", LengthUnits::decimeter.power(3));
-const Unit VolumeUnits::milliliter("milliliter", "mL", 0.001 * VolumeUnits::liter);
-const Unit VolumeUnits::centiliter("centiliter", "cL", 0.01 * VolumeUnits::liter);
-const Unit VolumeUnits::deciliter("deciliter", "dL", 0.1 * VolumeUnits::liter);
-const Unit VolumeUnits::meter3("meter^3", "m^3", LengthUnits::meter.power(3));
+QUANTIFY_STANDARD_UNIT(VolumeUnits, liter, "liter", "L", volumeDimensions, literFactor);
+QUANTIFY_STANDARD_UNIT(VolumeUnits, milliliter, "milliliter", "mL", volumeDimensions, Rational(1, 1, -6));
+QUANTIFY_STANDARD_UNIT(VolumeUnits, centiliter, "centiliter", "cL", volumeDimensions, Rational(1, 1, -5));
+QUANTIFY_STANDARD_UNIT(VolumeUnits, deciliter, "deciliter", "dL", volumeDimensions, Rational(1, 1, -4));
+QUANTIFY_STANDARD_UNIT(VolumeUnits, meter3, "meter^3", "m^3", volumeDimensions);
 
 // Speed units
-const Unit SpeedUnits::meterPerSecond("meter/second", "m/s", LengthUnits::meter * TimeUnits::second.power(-1));
-const Unit SpeedUnits::kilometerPerHour("kilometer/hour", "km/h", LengthUnits::kilometer * TimeUnits::hour.power(-1));
-const Unit SpeedUnits::milePerHour("mile/hour", "mi/h", LengthUnits::mile * TimeUnits::hour.power(-1));
-const Unit SpeedUnits::knot("knot", "kn", 1.852 * SpeedUnits::kilometerPerHour);
+QUANTIFY_STANDARD_UNIT(SpeedUnits, meterPerSecond, "meter/second", "m/s", speedDimensions);
+QUANTIFY_STANDARD_UNIT(SpeedUnits, kilometerPerHour, "kilometer/hour", "km/h", speedDimensions, kilometerPerHourFactor);
+QUANTIFY_STANDARD_UNIT(SpeedUnits, milePerHour, "mile/hour", "mi/h", speedDimensions, Rational(1609344, 3600, -3));
+QUANTIFY_STANDARD_UNIT(SpeedUnits, knot, "knot", "kn", speedDimensions, Rational(1852 * 1000, 3600, -3));
 
 // Force units
-const Unit ForceUnits::newton("newton", "N", LengthUnits::meter * MassUnits::kilogram * TimeUnits::second.power(-2));
-const Unit ForceUnits::poundForce("pound-force", "lbf", 4.4482216152605 * ForceUnits::newton);
+QUANTIFY_STANDARD_UNIT(ForceUnits, newton, "newton", "N", forceDimensions);
+QUANTIFY_STANDARD_UNIT(ForceUnits, poundForce, "pound-force", "lbf", forceDimensions, poundForceFactor);
 
 // Energy units
-const Unit EnergyUnits::joule("joule", "J", LengthUnits::meter.power(2) * MassUnits::kilogram * TimeUnits::second.power(-2));
-const Unit EnergyUnits::kilojoule("kilojoule", "kJ", 1000.0 * EnergyUnits::joule);
-const Unit EnergyUnits::megajoule("megajoule", "MJ", 1000000.0 * EnergyUnits::joule);
-const Unit EnergyUnits::gigajoule("gigajoule", "GJ", 1000000000.0 * EnergyUnits::joule);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, joule, "joule", "J", energyDimensions);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, kilojoule, "kilojoule", "kJ", energyDimensions, Rational(1000));
+QUANTIFY_STANDARD_UNIT(EnergyUnits, megajoule, "megajoule", "MJ", energyDimensions, Rational(1000000));
+QUANTIFY_STANDARD_UNIT(EnergyUnits, gigajoule, "gigajoule", "GJ", energyDimensions, Rational(1000000000));
 
-const Unit EnergyUnits::watt("watt", "W", EnergyUnits::joule * TimeUnits::second.power(-1));
-const Unit EnergyUnits::kilowatt("kilowatt", "kW", 1000.0 * EnergyUnits::watt);
-const Unit EnergyUnits::megawatt("megawatt", "MW", 1000000.0 * EnergyUnits::watt);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, watt, "watt", "W", powerDimensions);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, kilowatt, "kilowatt", "kW", powerDimensions, Rational(1000));
+QUANTIFY_STANDARD_UNIT(EnergyUnits, megawatt, "megawatt", "MW", powerDimensions, Rational(1000000));
 
-const Unit EnergyUnits::wattSecond("watt-second", "Wsec", EnergyUnits::watt * TimeUnits::second);
-const Unit EnergyUnits::wattHour("watt-hour", "Wh", EnergyUnits::watt * TimeUnits::hour);
-const Unit EnergyUnits::kilowattHour("kilowatt-hour", "kWh", 1000.0 * EnergyUnits::wattHour);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, wattSecond, "watt-second", "Wsec", energyDimensions);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, wattHour, "watt-hour", "Wh", energyDimensions, wattHourFactor);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, kilowattHour, "kilowatt-hour", "kWh", energyDimensions, Rational(1000 * 3600));
 
-const Unit EnergyUnits::calorie("calorie", "cal", 4.1868 * EnergyUnits::joule);
-const Unit EnergyUnits::kilocalorie("kilocalorie", "kcal", 1000.0 * EnergyUnits::calorie);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, calorie, "calorie", "cal", energyDimensions, calorieFactor);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, kilocalorie, "kilocalorie", "kcal", energyDimensions, Rational(41868, 1, -1));
 
-const Unit EnergyUnits::horsePower("horsepower", "hp", 0.73549875 * EnergyUnits::kilowatt);
+QUANTIFY_STANDARD_UNIT(EnergyUnits, horsePower, "horsepower", "hp", powerDimensions, Rational(73549875, 1, -5));
 
 // Pressure units
-const Unit PressureUnits::pascal("pascal", "Pa", ForceUnits::newton * LengthUnits::meter.power(-2));
-const Unit PressureUnits::hectopascal("hectopascal", "hPa", 100.0 * PressureUnits::pascal);
-const Unit PressureUnits::kilopascal("kilopascal", "KPa", 1000.0 * PressureUnits::pascal);
-const Unit PressureUnits::bar("bar", "bar", 100000.0 * PressureUnits::pascal);
-const Unit PressureUnits::millibar("millibar", "mbar", 0.001 * PressureUnits::bar);
-const Unit PressureUnits::atmosphere("atmosphere", "atm", 101325.0 * PressureUnits::pascal);
-const Unit PressureUnits::poundPerSquareInch("pound per square inch", "psi", ForceUnits::poundForce * AreaUnits::inch2.power(-1));
+QUANTIFY_STANDARD_UNIT(PressureUnits, pascal, "pascal", "Pa", pressureDimensions);
+QUANTIFY_STANDARD_UNIT(PressureUnits, hectopascal, "hectopascal", "hPa", pressureDimensions, Rational(100));
+QUANTIFY_STANDARD_UNIT(PressureUnits, kilopascal, "kilopascal", "KPa", pressureDimensions, Rational(1000));
+QUANTIFY_STANDARD_UNIT(PressureUnits, bar, "bar", "bar", pressureDimensions, barFactor);
+QUANTIFY_STANDARD_UNIT(PressureUnits, millibar, "millibar", "mbar", pressureDimensions, Rational(100));
+QUANTIFY_STANDARD_UNIT(PressureUnits, atmosphere, "atmosphere", "atm", pressureDimensions, Rational(101325));
+QUANTIFY_STANDARD_UNIT(PressureUnits, poundPerSquareInch, "pound per square inch", "psi", pressureDimensions, Rational(44482216152605, 254 * 254, -13 + 8));
 
 // Frequency units
-const Unit FrequencyUnits::hertz("Hertz", "hz", TimeUnits::second.power(-1));
-const Unit FrequencyUnits::megahertz("MegaHertz", "Mhz", 1000000.0 * FrequencyUnits::hertz);
-const Unit FrequencyUnits::rpm("Revolutions per minute", "rpm", TimeUnits::minute.power(-1));
+QUANTIFY_STANDARD_UNIT(FrequencyUnits, hertz, "Hertz", "hz", frequencyDimensions);
+QUANTIFY_STANDARD_UNIT(FrequencyUnits, megahertz, "MegaHertz", "Mhz", frequencyDimensions, Rational(1000000));
+QUANTIFY_STANDARD_UNIT(FrequencyUnits, rpm, "Revolutions per minute", "rpm", frequencyDimensions, Rational(1, 60));
 
 // Torque units
-const Unit TorqueUnits::newtonMeter("newton-meter", "N*m", ForceUnits::newton * LengthUnits::meter);
-const Unit TorqueUnits::poundFoot("pound-foot ", "lbf*ft", ForceUnits::poundForce * LengthUnits::foot);
+QUANTIFY_STANDARD_UNIT(TorqueUnits, newtonMeter, "newton-meter", "N*m", energyDimensions);
+QUANTIFY_STANDARD_UNIT(TorqueUnits, poundFoot, "pound-foot ", "lbf*ft", energyDimensions, Rational(44482216152605 * 3048, 1, -13 - 4));
+
+// Address constants only, so the list is constant initialized as well
+static const Unit *const allUnits[] =
+{
+    &LengthUnits::meter,
+    &LengthUnits::millimeter,
+    &LengthUnits::centimeter,
+    &LengthUnits::decimeter,
+    &LengthUnits::decameter,
+    &LengthUnits::hectometer,
+    &LengthUnits::kilometer,
+    &LengthUnits::thou,
+    &LengthUnits::inch,
+    &LengthUnits::foot,
+    &LengthUnits::yard,
+    &LengthUnits::chain,
+    &LengthUnits::furlong,
+    &LengthUnits::mile,
+    &LengthUnits::nauticalMile,
+    &LengthUnits::lightYear,
+    &MassUnits::kilogram,
+    &MassUnits::gram,
+    &MassUnits::milligram,
+    &MassUnits::ton,
+    &MassUnits::ounce,
+    &MassUnits::pound,
+    &TimeUnits::second,
+    &TimeUnits::microsecond,
+    &TimeUnits::millisecond,
+    &TimeUnits::minute,
+    &TimeUnits::hour,
+    &TimeUnits::day,
+    &ElectricUnits::ampere,
+    &ElectricUnits::coulomb,
+    &ElectricUnits::volt,
+    &ElectricUnits::ohm,
+    &ElectricUnits::farad,
+    &TemperatureUnits::kelvin,
+    &TemperatureUnits::degreeCelsius,
+    &TemperatureUnits::degreeFahrenheit,
+    &AmountOfSubstanceUnits::mole,
+    &LuminousIntensityUnits::candela,
+    &AreaUnits::meter2,
+    &AreaUnits::are,
+    &AreaUnits::hectare,
+    &AreaUnits::kilometer2,
+    &AreaUnits::inch2,
+    &VolumeUnits::liter,
+    &VolumeUnits::milliliter,
+    &VolumeUnits::centiliter,
+    &VolumeUnits::deciliter,
+    &VolumeUnits::meter3,
+    &SpeedUnits::meterPerSecond,
+    &SpeedUnits::kilometerPerHour,
+    &SpeedUnits::milePerHour,
+    &SpeedUnits::knot,
+    &ForceUnits::newton,
+    &ForceUnits::poundForce,
+    &EnergyUnits::joule,
+    &EnergyUnits::kilojoule,
+    &EnergyUnits::megajoule,
+    &EnergyUnits::gigajoule,
+    &EnergyUnits::watt,
+    &EnergyUnits::kilowatt,
+    &EnergyUnits::megawatt,
+    &EnergyUnits::wattSecond,
+    &EnergyUnits::wattHour,
+    &EnergyUnits::kilowattHour,
+    &EnergyUnits::calorie,
+    &EnergyUnits::kilocalorie,
+    &EnergyUnits::horsePower,
+    &PressureUnits::pascal,
+    &PressureUnits::hectopascal,
+    &PressureUnits::kilopascal,
+    &PressureUnits::bar,
+    &PressureUnits::millibar,
+    &PressureUnits::atmosphere,
+    &PressureUnits::poundPerSquareInch,
+    &FrequencyUnits::hertz,
+    &FrequencyUnits::megahertz,
+    &FrequencyUnits::rpm,
+    &TorqueUnits::newtonMeter,
+    &TorqueUnits::poundFoot,
+};
+
+const Unit *const *AllUnits::getUnits()
+{
+    return allUnits;
+}
+
+std::size_t AllUnits::getCount()
+{
+    return sizeof(allUnits) / sizeof(allUnits[0]);
+}
 
 }
 }
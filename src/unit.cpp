@@ -24,49 +24,92 @@
 
 #include <quantify/unit.h>
 #include <cmath>
+#include <sstream>
+#include <quantify/compositioncache.h>
 #include <quantify/incompatibleunitsexception.h>
 #include <quantify/unitunsupportedoperationexception.h>
 #include <quantify/utils.h>
 
 namespace Quantify {
 
+namespace {
+
+UnitLabel::Pointer makeLabel(const std::string &name, const std::string &symbol)
+{
+    if(name.empty() && symbol.empty())
+        return UnitLabel::Pointer();
+
+    return UnitLabel::Pointer(new UnitLabel(name, symbol));
+}
+
+}
+
 Unit::Unit(std::string name, std::string symbol, Dimensions dimensions, double factor, double offset)
+    : body(new UnitBody(makeLabel(name, symbol), dimensions, factor, offset, Rational::fromDouble(factor)))
 {
-    this->dimensions = dimensions;
-    this->name = name;
-    this->symbol = symbol;
-    this->factor = factor;
-    this->offset = offset;
+
 }
 
-Unit::Unit(const Unit &other)
+Unit::Unit(std::string name, std::string symbol, Dimensions dimensions, const Rational &factor, double offset)
+    : body(new UnitBody(makeLabel(name, symbol), dimensions, factor.toDouble(), offset, factor))
 {
-    copyFrom(other);
+
 }
 
-Unit::Unit(Unit &&other)
+Unit::Unit(std::string name, std::string symbol, const Unit &baseUnit)
+    : body(new UnitBody(makeLabel(name, symbol), baseUnit.getDimensions(), baseUnit.getFactor(), baseUnit.getOffset(), baseUnit.getExactFactor()))
 {
-    moveFrom(other);
+
 }
 
-Unit &Unit::operator=(const Unit &other)
+Unit::Unit(UnitLabel::Pointer label, const Dimensions &dimensions, double factor, double offset, const Rational &exactFactor)
+    : body(new UnitBody(std::move(label), dimensions, factor, offset, exactFactor))
 {
-    if(this != &other)
-    {
-        copyFrom(other);
-    }
 
-    return *this;
 }
 
-Unit &Unit::operator=(Unit &&other)
+Unit Unit::fromDimensions(const Dimensions &dimensions, double factor)
 {
-    if(this != &other)
+    const Unit unit = fromDimensions(dimensions, Rational(1));
+
+    return (factor == 1.0) ? unit : factor * unit;
+}
+
+Unit Unit::fromDimensions(const Dimensions &dimensions, const Rational &factor)
+{
+    static const char *names[QUANTIFY_DIMENSIONS_COUNT] = {"meter", "kilogram", "second", "ampere", "kelvin", "mole", "candela"};
+    static const char *symbols[QUANTIFY_DIMENSIONS_COUNT] = {"m", "kg", "s", "A", "K", "mol", "cd"};
+
+    std::stringstream nameStream;
+    std::stringstream symbolStream;
+
+    for(int i=0; i<QUANTIFY_DIMENSIONS_COUNT; ++i)
     {
-        moveFrom(other);
+        const int exponent = (signed char) dimensions.get(i);
+        if(exponent == 0)
+            continue;
+
+        if(nameStream.tellp() > 0)
+        {
+            nameStream << "*";
+            symbolStream << "*";
+        }
+
+        nameStream << names[i];
+        symbolStream << symbols[i];
+
+        if(exponent != 1)
+        {
+            nameStream << "^" << exponent;
+            symbolStream << "^" << exponent;
+        }
     }
 
-    return *this;
+    Unit unit(nameStream.str(), symbolStream.str(), dimensions, Rational(1));
+    if(factor == Rational(1))
+        return unit;
+
+    return Unit(UnitLabel::Pointer(new UnitLabel(UnitLabel::Operation::MultiplyByValue, unit.getLabel(), factor.toDouble())), dimensions, factor.toDouble(), 0.0, factor);
 }
 
 void Unit::assertCompatibility(const Unit &other) const
@@ -79,7 +122,7 @@ void Unit::assertCompatibility(const Unit &other) const
 
 void Unit::assertCanMultiply() const
 {
-    if(!Utils::areEqual(this->offset, 0.0))
+    if(!Utils::areEqual(getOffset(), 0.0))
     {
         throw UnitUnsupportedOperationException(*this, "*");
     }
@@ -87,7 +130,7 @@ void Unit::assertCanMultiply() const
 
 void Unit::assertCanDivide() const
 {
-    if(!Utils::areEqual(this->offset, 0.0))
+    if(!Utils::areEqual(getOffset(), 0.0))
     {
         throw UnitUnsupportedOperationException(*this, "/");
     }
@@ -102,50 +145,39 @@ Unit Unit::power(int power) const
 {
     assertCanMultiply();
 
-    std::stringstream nameStream;
-    nameStream << name << "^" << power;
+    Unit result;
+    if(CompositionCache::find(UnitLabel::Operation::Power, *this, *this, power, result))
+        return result;
 
-    std::stringstream symbolStream;
-    symbolStream << symbol << "^" << power;
+    result = Unit(UnitLabel::Pointer(new UnitLabel(getLabel(), power)), getDimensions().power(power), pow(getFactor(), (double)power), 0.0, getExactFactor().power(power));
+    CompositionCache::insert(UnitLabel::Operation::Power, *this, *this, power, result);
 
-    return Unit(nameStream.str(), symbolStream.str(), dimensions.power(power), pow(factor, (double)power));
+    return result;
 }
 
 bool Unit::equals(const Unit &other) const
 {    
-    return isCompatibleTo(other) && Utils::areEqual(factor, other.factor);
+    return getId() == other.getId();
 }
 
 bool Unit::lessThan(const Unit &other) const
 {    
-    return isCompatibleTo(other) && (factor < other.factor);
+    return isCompatibleTo(other) && (getFactor() < other.getFactor());
 }
 
 bool Unit::greaterThan(const Unit &other) const
 {    
-    return isCompatibleTo(other) && (factor > other.factor);
+    return isCompatibleTo(other) && (getFactor() > other.getFactor());
 }
 
 Unit Unit::add(double value) const
 {
-    std::stringstream nameStream;
-    nameStream << "(" << name << "+" << value << ")";
-
-    std::stringstream symbolStream;
-    symbolStream << symbol << "+" << value;
-
-    return Unit(nameStream.str(), symbolStream.str(), dimensions, factor, offset + value);
+    return Unit(UnitLabel::Pointer(new UnitLabel(UnitLabel::Operation::Add, getLabel(), value)), getDimensions(), getFactor(), getOffset() + value, getExactFactor());
 }
 
 Unit Unit::subtract(double value) const
 {
-    std::stringstream nameStream;
-    nameStream << "(" << name << "-" << value << ")";
-
-    std::stringstream symbolStream;
-    symbolStream << symbol << "-" << value;
-
-    return Unit(nameStream.str(), symbolStream.str(), dimensions, factor, offset - value);
+    return Unit(UnitLabel::Pointer(new UnitLabel(UnitLabel::Operation::Subtract, getLabel(), value)), getDimensions(), getFactor(), getOffset() - value, getExactFactor());
 }
 
 Unit Unit::multiplyBy(const Unit &other) const
@@ -153,26 +185,21 @@ Unit Unit::multiplyBy(const Unit &other) const
     other.assertCanMultiply();
     assertCanMultiply();
 
-    std::stringstream nameStream;
-    nameStream << name << "*" << other.name;
+    Unit result;
+    if(CompositionCache::find(UnitLabel::Operation::Multiply, *this, other, 0, result))
+        return result;
 
-    std::stringstream symbolStream;
-    symbolStream << symbol << "*" << other.symbol;
+    result = Unit(UnitLabel::Pointer(new UnitLabel(UnitLabel::Operation::Multiply, getLabel(), other.getLabel())), getDimensions() * other.getDimensions(), getFactor() * other.getFactor(), 0.0, getExactFactor().multiplyBy(other.getExactFactor()));
+    CompositionCache::insert(UnitLabel::Operation::Multiply, *this, other, 0, result);
 
-    return Unit(nameStream.str(), symbolStream.str(), dimensions * other.dimensions, factor * other.factor);
+    return result;
 }
 
 Unit Unit::multiplyBy(double value) const
 {    
     assertCanMultiply();
 
-    std::stringstream nameStream;
-    nameStream << value << "*" << name;
-
-    std::stringstream symbolStream;
-    symbolStream << value << "*" << symbol;
-
-    return Unit(nameStream.str(), symbolStream.str(), dimensions, value * factor);
+    return Unit(UnitLabel::Pointer(new UnitLabel(UnitLabel::Operation::MultiplyByValue, getLabel(), value)), getDimensions(), value * getFactor(), 0.0, Rational::fromDouble(value).multiplyBy(getExactFactor()));
 }
 
 Unit Unit::divideBy(const Unit &other) const
@@ -180,97 +207,100 @@ Unit Unit::divideBy(const Unit &other) const
     other.assertCanDivide();
     assertCanDivide();
 
-    std::stringstream nameStream;
-    nameStream << name << "/" << other.name;
+    Unit result;
+    if(CompositionCache::find(UnitLabel::Operation::Divide, *this, other, 0, result))
+        return result;
 
-    std::stringstream symbolStream;
-    symbolStream << symbol << "/" << other.symbol;
+    result = Unit(UnitLabel::Pointer(new UnitLabel(UnitLabel::Operation::Divide, getLabel(), other.getLabel())), getDimensions() / other.getDimensions(), getFactor() / other.getFactor(), 0.0, getExactFactor().divideBy(other.getExactFactor()));
+    CompositionCache::insert(UnitLabel::Operation::Divide, *this, other, 0, result);
 
-    return Unit(nameStream.str(), symbolStream.str(), dimensions / other.dimensions, factor / other.factor);
+    return result;
 }
 
 Unit Unit::divideBy(double value) const
 {
     assertCanDivide();
 
-    std::stringstream nameStream;
-    nameStream << name << "/" << value;
+    return Unit(UnitLabel::Pointer(new UnitLabel(UnitLabel::Operation::DivideByValue, getLabel(), value)), getDimensions(), getFactor() / value, 0.0, getExactFactor().divideBy(Rational::fromDouble(value)));
+}
 
-    std::stringstream symbolStream;
-    symbolStream << symbol << "/" << value;
+OperationStatus Unit::tryPower(int power, Unit &result) const
+{
+    if(!Utils::areEqual(getOffset(), 0.0))
+        return OperationStatus::UnsupportedOperation;
+    if(getDimensions().powerOverflows(power))
+        return OperationStatus::DimensionsOverflow;
 
-    return Unit(nameStream.str(), symbolStream.str(), dimensions, factor / value);
+    result = this->power(power);
+    return OperationStatus::Ok;
 }
 
-std::string Unit::getName() const
+OperationStatus Unit::tryMultiplyBy(const Unit &other, Unit &result) const
 {
-    return name;
+    if(!Utils::areEqual(getOffset(), 0.0) || !Utils::areEqual(other.getOffset(), 0.0))
+        return OperationStatus::UnsupportedOperation;
+    if(Dimensions::addOverflows(getDimensions().getPacked(), other.getDimensions().getPacked()))
+        return OperationStatus::DimensionsOverflow;
+
+    result = multiplyBy(other);
+    return OperationStatus::Ok;
 }
 
-double Unit::getFactor() const
+OperationStatus Unit::tryDivideBy(const Unit &other, Unit &result) const
 {
-    return factor;
+    if(!Utils::areEqual(getOffset(), 0.0) || !Utils::areEqual(other.getOffset(), 0.0))
+        return OperationStatus::UnsupportedOperation;
+    if(Dimensions::subtractOverflows(getDimensions().getPacked(), other.getDimensions().getPacked()))
+        return OperationStatus::DimensionsOverflow;
+
+    result = divideBy(other);
+    return OperationStatus::Ok;
 }
 
-std::string Unit::getSymbol() const
+Unit operator/(double left, const Unit &right)
 {
-    return symbol;
+    right.assertCanDivide();
+
+    return Unit(UnitLabel::Pointer(new UnitLabel(UnitLabel::Operation::ValueDividedBy, right.getLabel(), left)), right.getDimensions().power(-1), left / right.getFactor(), 0.0, Rational::fromDouble(left).divideBy(right.getExactFactor()));
 }
 
-Dimensions Unit::getDimensions() const
+const std::string &Unit::getName() const
 {
-    return dimensions;
+    static const std::string empty;
+
+    return getLabel() ? getLabel()->getName() : empty;
 }
 
-double Unit::getOffset() const
+const std::string &Unit::getSymbol() const
 {
-    return offset;
+    static const std::string empty;
+
+    return getLabel() ? getLabel()->getSymbol() : empty;
 }
 
 void Unit::setName(const std::string &value)
 {
-    name = value;
+    *this = Unit(UnitLabel::Pointer(new UnitLabel(value, getSymbol())), getDimensions(), getFactor(), getOffset(), getExactFactor());
 }
 
 void Unit::setSymbol(const std::string &value)
 {
-    symbol = value;
+    *this = Unit(UnitLabel::Pointer(new UnitLabel(getName(), value)), getDimensions(), getFactor(), getOffset(), getExactFactor());
 }
 
 void Unit::setFactor(double value)
 {
-    factor = value;
+    *this = Unit(getLabel(), getDimensions(), value, getOffset(), Rational::fromDouble(value));
 }
 
 void Unit::setDimensions(const Dimensions &value)
 {
-    dimensions = value;
+    *this = Unit(getLabel(), value, getFactor(), getOffset(), getExactFactor());
 }
 
 void Unit::setOffset(double value)
 {
-    offset = value;
-}
-
-void Unit::copyFrom(const Unit &other)
-{
-    dimensions = other.dimensions;
-    name = other.name;
-    symbol = other.symbol;
-    factor = other.factor;
-    offset = other.offset;
-}
-
-void Unit::moveFrom(Unit &other)
-{
-    dimensions = std::move(other.dimensions);
-    name = std::move(other.name);
-    symbol = std::move(other.symbol);
-    factor = other.factor;
-    offset = other.offset;
-
-    other.factor = 0;
-    other.offset = 0;
+    *this = Unit(getLabel(), getDimensions(), getFactor(), value, getExactFactor());
 }
 
 }
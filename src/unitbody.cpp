@@ -0,0 +1,51 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/unitbody.h>
+#include <quantify/unitinterner.h>
+
+namespace Quantify {
+
+const UnitBody UnitBody::empty(nullptr, Dimensions());
+
+UnitBody::UnitBody(UnitLabel::Pointer label, const Dimensions &dimensions, double factor, double offset, const Rational &exactFactor)
+    : label(std::move(label)), factor(exactFactor.isValid() ? exactFactor.toDouble() : factor), offset(offset), dimensions(dimensions), exactFactor(exactFactor), id(0), counted(true), references(1)
+{
+
+}
+
+std::uint32_t UnitBody::intern() const
+{
+    const std::uint32_t value = UnitInterner::intern(dimensions, factor, offset);
+    id.store(value, std::memory_order_relaxed);
+
+    return value;
+}
+
+void UnitBody::destroy(const UnitBody *object)
+{
+    delete object;
+}
+
+}
@@ -0,0 +1,135 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/unitinterner.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#define QUANTIFY_UNIT_INTERNER_SIGNIFICANT_BITS 40
+
+namespace Quantify {
+
+namespace {
+
+// bits of the value rounded to QUANTIFY_UNIT_INTERNER_SIGNIFICANT_BITS, with
+// a single representation for zero and for NaN
+std::uint64_t canonicalBits(double value)
+{
+    if(value == 0.0)
+        value = 0.0;
+    else if(std::isnan(value))
+        value = std::numeric_limits<double>::quiet_NaN();
+    else if(std::isfinite(value))
+    {
+        int exponent = 0;
+        const double mantissa = std::frexp(value, &exponent);
+        value = std::ldexp(std::round(std::ldexp(mantissa, QUANTIFY_UNIT_INTERNER_SIGNIFICANT_BITS)), exponent - QUANTIFY_UNIT_INTERNER_SIGNIFICANT_BITS);
+    }
+
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    return bits;
+}
+
+struct UnitKey
+{
+    std::uint64_t dimensions;
+    std::uint64_t factor;
+    std::uint64_t offset;
+
+    bool operator==(const UnitKey &other) const
+    {
+        return dimensions == other.dimensions && factor == other.factor && offset == other.offset;
+    }
+};
+
+struct UnitKeyHash
+{
+    std::size_t operator()(const UnitKey &key) const
+    {
+        std::uint64_t hash = key.dimensions * 0x9E3779B97F4A7C15ULL;
+        hash = (hash ^ key.factor) * 0x9E3779B97F4A7C15ULL;
+        hash = (hash ^ key.offset) * 0x9E3779B97F4A7C15ULL;
+
+        return (std::size_t) (hash ^ (hash >> 32));
+    }
+};
+
+class UnitTable
+{
+public:
+    std::uint32_t intern(const Dimensions &dimensions, double factor, double offset)
+    {
+        const UnitKey key = {dimensions.getPacked(), canonicalBits(factor), canonicalBits(offset)};
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = ids.find(key);
+        if(it != ids.end())
+            return it->second;
+
+        if(ids.size() >= std::numeric_limits<std::uint32_t>::max())
+            throw std::overflow_error("Too many distinct units to intern.");
+
+        const std::uint32_t id = (std::uint32_t) ids.size() + 1;
+        ids.insert(std::make_pair(key, id));
+
+        return id;
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ids.size();
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<UnitKey, std::uint32_t, UnitKeyHash> ids;
+};
+
+UnitTable &unitTable()
+{
+    static UnitTable table;
+    return table;
+}
+
+}
+
+std::uint32_t UnitInterner::intern(const Dimensions &dimensions, double factor, double offset)
+{
+    return unitTable().intern(dimensions, factor, offset);
+}
+
+std::size_t UnitInterner::size()
+{
+    return unitTable().size();
+}
+
+}
@@ -0,0 +1,174 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/unitlabel.h>
+#include <sstream>
+
+namespace Quantify {
+
+UnitLabel::UnitLabel(const std::string &name, const std::string &symbol)
+    : operation(Operation::None), text(new char[name.size() + symbol.size() + 2]), value(0), power(0), renderedName(nullptr), renderedSymbol(nullptr), counted(true), references(1)
+{
+    name.copy(text.get(), name.size());
+    text[name.size()] = '\0';
+    symbol.copy(text.get() + name.size() + 1, symbol.size());
+    text[name.size() + symbol.size() + 1] = '\0';
+
+    this->name = text.get();
+    this->symbol = text.get() + name.size() + 1;
+}
+
+UnitLabel::UnitLabel(Operation operation, Pointer left, Pointer right)
+    : operation(operation), name(""), symbol(""), left(std::move(left)), right(std::move(right)), value(0), power(0), renderedName(nullptr), renderedSymbol(nullptr), counted(true), references(1)
+{
+
+}
+
+UnitLabel::UnitLabel(Operation operation, Pointer operand, double value)
+    : operation(operation), name(""), symbol(""), left(std::move(operand)), value(value), power(0), renderedName(nullptr), renderedSymbol(nullptr), counted(true), references(1)
+{
+
+}
+
+UnitLabel::UnitLabel(Pointer operand, int power)
+    : operation(Operation::Power), name(""), symbol(""), left(std::move(operand)), value(0), power(power), renderedName(nullptr), renderedSymbol(nullptr), counted(true), references(1)
+{
+
+}
+
+UnitLabel::~UnitLabel()
+{
+    delete renderedName.load(std::memory_order_relaxed);
+    delete renderedSymbol.load(std::memory_order_relaxed);
+}
+
+const std::string &UnitLabel::getName() const
+{
+    return getText(renderedName, false);
+}
+
+const std::string &UnitLabel::getSymbol() const
+{
+    return getText(renderedSymbol, true);
+}
+
+UnitLabel::Operation UnitLabel::getOperation() const
+{
+    return operation;
+}
+
+void UnitLabel::writeName(std::ostream &outputStream) const
+{
+    write(outputStream, false);
+}
+
+void UnitLabel::writeSymbol(std::ostream &outputStream) const
+{
+    write(outputStream, true);
+}
+
+const std::string &UnitLabel::getText(std::atomic<const std::string*> &rendered, bool symbol) const
+{
+    const std::string *text = rendered.load(std::memory_order_acquire);
+    if(text)
+        return *text;
+
+    std::unique_ptr<const std::string> candidate;
+    if(operation == Operation::None)
+    {
+        candidate.reset(new std::string(symbol ? this->symbol : this->name));
+    }
+    else
+    {
+        std::stringstream textStream;
+        write(textStream, symbol);
+        candidate.reset(new std::string(textStream.str()));
+    }
+
+    // another thread may render the same text concurrently, the first one wins
+    if(rendered.compare_exchange_strong(text, candidate.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+        return *candidate.release();
+
+    return *text;
+}
+
+void UnitLabel::write(std::ostream &outputStream, const Pointer &label, bool symbol)
+{
+    if(label)
+    {
+        label->write(outputStream, symbol);
+    }
+}
+
+void UnitLabel::write(std::ostream &outputStream, bool symbol) const
+{
+    switch(operation)
+    {
+    case Operation::None:
+        outputStream << (symbol ? this->symbol : this->name);
+        break;
+    case Operation::Multiply:
+        write(outputStream, left, symbol);
+        outputStream << "*";
+        write(outputStream, right, symbol);
+        break;
+    case Operation::Divide:
+        write(outputStream, left, symbol);
+        outputStream << "/";
+        write(outputStream, right, symbol);
+        break;
+    case Operation::Power:
+        write(outputStream, left, symbol);
+        outputStream << "^" << power;
+        break;
+    case Operation::Add:
+    case Operation::Subtract:
+        if(!symbol)
+            outputStream << "(";
+        write(outputStream, left, symbol);
+        outputStream << (operation == Operation::Add ? "+" : "-") << value;
+        if(!symbol)
+            outputStream << ")";
+        break;
+    case Operation::MultiplyByValue:
+        outputStream << value << "*";
+        write(outputStream, left, symbol);
+        break;
+    case Operation::DivideByValue:
+        write(outputStream, left, symbol);
+        outputStream << "/" << value;
+        break;
+    case Operation::ValueDividedBy:
+        outputStream << value << "/";
+        write(outputStream, left, symbol);
+        break;
+    }
+}
+
+void UnitLabel::destroy(const UnitLabel *object)
+{
+    delete object;
+}
+
+}
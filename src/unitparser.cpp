@@ -0,0 +1,448 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/unitparser.h>
+#include <quantify/lrucache.h>
+#include <quantify/unitparseexception.h>
+#include <quantify/unitregistry.h>
+#include <quantify/rational.h>
+#include <cstring>
+#include <locale>
+#include <sstream>
+
+#define QUANTIFY_UNIT_PARSER_CACHE_CAPACITY 1024
+#define QUANTIFY_UNIT_PARSER_MAX_EXPONENT 1000
+
+namespace Quantify {
+
+namespace {
+
+struct Prefix
+{
+    const char *symbol;
+    const char *name;
+    Rational factor;
+};
+
+const Prefix prefixes[] =
+{
+    {"Y", "yotta", Rational(1, 1, 24)},
+    {"Z", "zetta", Rational(1, 1, 21)},
+    {"E", "exa", Rational(1, 1, 18)},
+    {"P", "peta", Rational(1, 1, 15)},
+    {"T", "tera", Rational(1, 1, 12)},
+    {"G", "giga", Rational(1, 1, 9)},
+    {"M", "mega", Rational(1, 1, 6)},
+    {"k", "kilo", Rational(1, 1, 3)},
+    {"h", "hecto", Rational(1, 1, 2)},
+    {"da", "deca", Rational(1, 1, 1)},
+    {"d", "deci", Rational(1, 1, -1)},
+    {"c", "centi", Rational(1, 1, -2)},
+    {"m", "milli", Rational(1, 1, -3)},
+    {"μ", "micro", Rational(1, 1, -6)},
+    {"u", "micro", Rational(1, 1, -6)},
+    {"n", "nano", Rational(1, 1, -9)},
+    {"p", "pico", Rational(1, 1, -12)},
+    {"f", "femto", Rational(1, 1, -15)},
+    {"a", "atto", Rational(1, 1, -18)},
+    {"z", "zepto", Rational(1, 1, -21)},
+    {"y", "yocto", Rational(1, 1, -24)}
+};
+
+bool findPrefixed(const UnitRegistry &registry, const std::string &identifier, const char *prefixText, const Prefix &prefix,
+                  bool bySymbol, Unit &unit)
+{
+    const std::size_t prefixLength = std::strlen(prefixText);
+    if(identifier.size() <= prefixLength || identifier.compare(0, prefixLength, prefixText) != 0)
+        return false;
+
+    const char *rest = identifier.data() + prefixLength;
+    const std::size_t restLength = identifier.size() - prefixLength;
+    Unit base;
+    if(!(bySymbol ? registry.findBySymbol(rest, restLength, base) : registry.findByName(rest, restLength, base)) || base.getOffset() != 0.0)
+        return false;
+
+    // the exact factor carries over when the base unit has one
+    const Rational factor = prefix.factor * base.getExactFactor();
+    if(factor.isValid())
+        unit = Unit(prefix.name + base.getName(), prefix.symbol + base.getSymbol(), base.getDimensions(), factor);
+    else
+        unit = Unit(prefix.name + base.getName(), prefix.symbol + base.getSymbol(), base.getDimensions(), prefix.factor.toDouble() * base.getFactor());
+    return true;
+}
+
+// Registry lookup by symbol, by name, then as a prefixed symbol or name
+bool findIdentifier(const std::string &identifier, Unit &unit)
+{
+    const UnitRegistry &registry = UnitRegistry::getDefault();
+
+    if(registry.findBySymbol(identifier, unit) || registry.findByName(identifier, unit))
+        return true;
+
+    for(const Prefix &prefix : prefixes)
+    {
+        if(findPrefixed(registry, identifier, prefix.symbol, prefix, true, unit)
+           || findPrefixed(registry, identifier, prefix.name, prefix, false, unit))
+            return true;
+    }
+
+    return false;
+}
+
+// entries parsed against an older registry generation are treated as misses
+struct CachedUnit
+{
+    std::uint32_t generation;
+    Unit unit;
+};
+
+LruCache<std::string, CachedUnit> &cache()
+{
+    static LruCache<std::string, CachedUnit> instance(QUANTIFY_UNIT_PARSER_CACHE_CAPACITY);
+    return instance;
+}
+
+// Recursive descent over
+//   product := power (('*' | '·' | '/' | ' ') power)*
+//   power   := primary ('^' integer)?
+//   primary := '(' product ')' | number | identifier integer?
+class ExpressionParser
+{
+public:
+    explicit ExpressionParser(const std::string &expression) : expression(expression), position(0) {}
+
+    Unit parse()
+    {
+        skipSpaces();
+        if(atEnd())
+            fail("empty expression");
+
+        Unit unit = parseProduct();
+        skipSpaces();
+        if(!atEnd())
+            fail(peek() == ')' ? "unbalanced parenthesis" : "unexpected character");
+
+        return unit;
+    }
+
+private:
+    Unit parseProduct()
+    {
+        Unit unit = parsePower();
+
+        for(;;)
+        {
+            skipSpaces();
+            if(atEnd() || peek() == ')')
+                return unit;
+
+            if(peek() == '/')
+            {
+                ++position;
+                unit = combine(unit, true);
+            }
+            else if(peek() == '*' || isMiddleDot())
+            {
+                position += peek() == '*' ? 1 : 2;
+                unit = combine(unit, false);
+            }
+            else if(peek() == '^')
+            {
+                fail("misplaced exponent");
+            }
+            else
+            {
+                unit = combine(unit, false);
+            }
+        }
+    }
+
+    Unit combine(const Unit &left, bool divide)
+    {
+        const std::size_t start = position;
+        const Unit right = parsePower();
+
+        const std::uint64_t leftDimensions = left.getDimensions().getPacked();
+        const std::uint64_t rightDimensions = right.getDimensions().getPacked();
+        if(divide ? Dimensions::subtractOverflows(leftDimensions, rightDimensions) : Dimensions::addOverflows(leftDimensions, rightDimensions))
+        {
+            position = start;
+            fail("dimension exponent out of range");
+        }
+
+        return divide ? left / right : left * right;
+    }
+
+    Unit parsePower()
+    {
+        Unit unit = parsePrimary();
+
+        skipSpaces();
+        if(!atEnd() && peek() == '^')
+        {
+            ++position;
+            skipSpaces();
+            unit = parseExponent(unit);
+        }
+
+        return unit;
+    }
+
+    // integer exponent at the current position applied to unit
+    Unit parseExponent(const Unit &unit)
+    {
+        const std::size_t start = position;
+
+        int power = 0;
+        if(!parseInteger(power))
+            fail("expected an integer exponent");
+        if(power == 1)
+            return unit;
+
+        if(unit.getDimensions().powerOverflows(power))
+        {
+            position = start;
+            fail("dimension exponent out of range");
+        }
+
+        return unit.power(power);
+    }
+
+    Unit parsePrimary()
+    {
+        skipSpaces();
+        if(atEnd())
+            fail("expected a unit");
+
+        if(peek() == '(')
+        {
+            ++position;
+            Unit unit = parseProduct();
+            skipSpaces();
+            if(atEnd() || peek() != ')')
+                fail("unbalanced parenthesis");
+            ++position;
+            return unit;
+        }
+
+        if(isDigit(peek()) || peek() == '.')
+            return parseNumber();
+
+        return parseIdentifier();
+    }
+
+    Unit parseNumber()
+    {
+        const std::size_t start = position;
+        bool seenPoint = false;
+        bool seenDigit = false;
+
+        for(; !atEnd(); ++position)
+        {
+            const char c = peek();
+            if(isDigit(c))
+            {
+                seenDigit = true;
+            }
+            else if(c == '.' && !seenPoint)
+            {
+                seenPoint = true;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if(!seenDigit)
+            fail("malformed number");
+
+        // only digits and one point were scanned, they are read with the
+        // classic locale so the decimal point does not depend on the global one
+        const std::string text = expression.substr(start, position - start);
+        std::istringstream stream(text);
+        stream.imbue(std::locale::classic());
+        double value = 0.0;
+        stream >> value;
+
+        return Unit(text, text, Dimensions(), value);
+    }
+
+    Unit parseIdentifier()
+    {
+        const std::size_t start = position;
+        while(!atEnd() && !isDelimiter())
+            ++position;
+
+        if(position == start)
+            fail("expected a unit");
+
+        const std::string identifier = expression.substr(start, position - start);
+        Unit unit;
+        if(findIdentifier(identifier, unit))
+            return unit;
+
+        // exponent glued to the symbol, as in "m2" or "s-1"
+        std::size_t split = identifier.size();
+        while(split > 0 && isDigit(identifier[split - 1]))
+            --split;
+        if(split > 0 && split < identifier.size() && identifier[split - 1] == '-')
+            --split;
+
+        if(split > 0 && split < identifier.size() && findIdentifier(identifier.substr(0, split), unit))
+        {
+            position = start + split;
+            return parseExponent(unit);
+        }
+
+        position = start;
+        fail("unknown unit");
+        return unit;
+    }
+
+    bool parseInteger(int &value)
+    {
+        const std::size_t signStart = position;
+        bool negative = false;
+        if(!atEnd() && (peek() == '-' || peek() == '+'))
+        {
+            negative = peek() == '-';
+            ++position;
+        }
+
+        const std::size_t start = position;
+        long result = 0;
+        while(!atEnd() && isDigit(peek()))
+        {
+            // saturates, anything above the maximum is rejected below
+            if(result <= QUANTIFY_UNIT_PARSER_MAX_EXPONENT)
+                result = result * 10 + (peek() - '0');
+            ++position;
+        }
+
+        if(position == start)
+            return false;
+
+        if(result > QUANTIFY_UNIT_PARSER_MAX_EXPONENT)
+        {
+            position = signStart;
+            fail("exponent out of range");
+        }
+
+        value = (int) (negative ? -result : result);
+        return true;
+    }
+
+    bool isDelimiter() const
+    {
+        const char c = peek();
+        return c == ' ' || c == '\t' || c == '*' || c == '/' || c == '^' || c == '(' || c == ')' || isMiddleDot();
+    }
+
+    bool isMiddleDot() const
+    {
+        return expression.compare(position, 2, "\xC2\xB7") == 0;
+    }
+
+    static bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    void skipSpaces()
+    {
+        while(!atEnd() && (peek() == ' ' || peek() == '\t'))
+            ++position;
+    }
+
+    bool atEnd() const
+    {
+        return position >= expression.size();
+    }
+
+    char peek() const
+    {
+        return expression[position];
+    }
+
+    void fail(const char *reason) const
+    {
+        throw UnitParseException(expression, position, reason);
+    }
+
+    const std::string &expression;
+    std::size_t position;
+};
+
+}
+
+Unit UnitParser::parse(const std::string &expression)
+{
+    const std::uint32_t generation = UnitRegistry::getDefault().getGeneration();
+
+    CachedUnit cached = {0, Unit()};
+    if(cache().get(expression, cached) && cached.generation == generation)
+        return cached.unit;
+
+    // whole symbols such as "km/h" or "N*m" keep their standard name
+    Unit unit;
+    if(!findIdentifier(expression, unit))
+        unit = ExpressionParser(expression).parse();
+
+    unit.getId();
+    cached.generation = generation;
+    cached.unit = unit;
+    cache().put(expression, cached);
+
+    return unit;
+}
+
+void UnitParser::addUnit(const Unit &unit)
+{
+    UnitRegistry::getDefault().add(unit);
+    cache().clear();
+}
+
+std::uint32_t UnitParser::getGeneration()
+{
+    return UnitRegistry::getDefault().getGeneration();
+}
+
+UnitParser::Statistics UnitParser::getStatistics()
+{
+    Statistics statistics = {cache().getHits(), cache().getMisses(), cache().size(), cache().getCapacity()};
+    return statistics;
+}
+
+void UnitParser::setCacheCapacity(std::size_t value)
+{
+    cache().setCapacity(value);
+}
+
+void UnitParser::clearCache()
+{
+    cache().clear();
+}
+
+}
@@ -0,0 +1,607 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <quantify/unitregistry.h>
+#include <quantify/standardunits.h>
+#include <cstring>
+#include <thread>
+
+#define QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT UINT32_MAX
+#define QUANTIFY_UNIT_REGISTRY_DELETED_SLOT (UINT32_MAX - 1)
+#define QUANTIFY_UNIT_REGISTRY_MIN_SLOTS 16
+
+namespace Quantify {
+
+namespace {
+
+// power of two with at least twice as many slots as entries
+std::size_t slotCountFor(std::size_t entries)
+{
+    std::size_t count = QUANTIFY_UNIT_REGISTRY_MIN_SLOTS;
+    while(count < entries * 2)
+        count *= 2;
+
+    return count;
+}
+
+std::uint64_t mix(std::uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+
+    return value;
+}
+
+struct Slot
+{
+    std::uint32_t hash;
+    std::uint32_t index;
+};
+
+// open addressing table, used counts the deleted slots too since they still
+// lengthen the probe sequences
+struct SlotTable
+{
+    std::vector<Slot> slots;
+    std::size_t used;
+};
+
+struct DimensionSlot
+{
+    std::uint64_t packed;
+    std::uint32_t begin;
+    std::uint32_t count;
+    bool used;
+};
+
+std::uint32_t hashOf(const char *text, std::size_t length)
+{
+    std::uint32_t hash = 2166136261u;
+    for(std::size_t i=0; i<length; ++i)
+    {
+        hash ^= (unsigned char) text[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+const std::string &keyOf(const Unit &unit, bool symbol)
+{
+    return symbol ? unit.getSymbol() : unit.getName();
+}
+
+std::atomic<std::size_t> snapshotCount(0);
+
+// spreads reader threads over the reader counters, assigned on first lookup
+std::size_t readerStripe()
+{
+    static std::atomic<std::size_t> nextStripe(0);
+    static thread_local const std::size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % QUANTIFY_UNIT_REGISTRY_READER_STRIPES;
+
+    return stripe;
+}
+
+}
+
+// Immutable once published, readers use it without synchronization. Writers
+// copy the current snapshot and only update the indexes for the units added
+// or replaced: entries are appended and never move, so the symbol and name
+// tables keep their slots, and units are grouped by dimensions in a second
+// array so every dimension is one contiguous range.
+class UnitRegistry::Snapshot
+{
+public:
+    Snapshot()
+        : generation(0), counted(true), references(1), usedDimensionSlots(0), deadEntries(0)
+    {
+        snapshotCount.fetch_add(1, std::memory_order_relaxed);
+        reset(symbols, QUANTIFY_UNIT_REGISTRY_MIN_SLOTS);
+        reset(names, QUANTIFY_UNIT_REGISTRY_MIN_SLOTS);
+        dimensionSlots.assign(QUANTIFY_UNIT_REGISTRY_MIN_SLOTS, DimensionSlot());
+    }
+
+    Snapshot(const Snapshot &other)
+        : entries(other.entries), units(other.units), unitEntries(other.unitEntries), generation(other.generation + 1), counted(true), references(1),
+          symbols(other.symbols), names(other.names), dimensionSlots(other.dimensionSlots), usedDimensionSlots(other.usedDimensionSlots),
+          deadEntries(other.deadEntries)
+    {
+        snapshotCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Snapshot &operator=(const Snapshot &other) = delete;
+
+    const Unit *findBySymbol(const char *text, std::size_t length) const
+    {
+        const std::uint32_t index = find(symbols, true, text, length);
+        return index == QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT ? nullptr : &entries[index];
+    }
+
+    const Unit *findByName(const char *text, std::size_t length) const
+    {
+        const std::uint32_t index = find(names, false, text, length);
+        return index == QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT ? nullptr : &entries[index];
+    }
+
+    bool findByDimensions(const Dimensions &dimensions, const Unit *&first, const Unit *&last) const
+    {
+        const std::size_t i = findDimensions(dimensions.getPacked());
+        if(i == dimensionSlots.size() || dimensionSlots[i].count == 0)
+            return false;
+
+        first = units.data() + dimensionSlots[i].begin;
+        last = first + dimensionSlots[i].count;
+        return true;
+    }
+
+    // new reference, only taken while the snapshot is published or pinned by a reader
+    SnapshotPointer share() const
+    {
+        references.fetch_add(1, std::memory_order_relaxed);
+        return SnapshotPointer(this);
+    }
+
+    static void destroy(const Snapshot *object)
+    {
+        delete object;
+        snapshotCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // a new unit replaces the ones it shares a symbol or a name with
+    void add(const Unit &unit)
+    {
+        const std::string &symbol = unit.getSymbol();
+        const std::string &name = unit.getName();
+
+        std::uint32_t replaced = find(symbols, true, symbol.data(), symbol.size());
+        if(replaced != QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT)
+            remove(replaced);
+
+        replaced = find(names, false, name.data(), name.size());
+        if(replaced != QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT)
+            remove(replaced);
+
+        const std::uint32_t index = (std::uint32_t) entries.size();
+        entries.push_back(unit);
+        entries.back().getId();
+        insert(symbols, true, index);
+        insert(names, false, index);
+        insertIntoGroup(index);
+
+        if(deadEntries > units.size() + QUANTIFY_UNIT_REGISTRY_MIN_SLOTS)
+            compact();
+        else if(symbols.used * 2 > symbols.slots.size() || names.used * 2 > names.slots.size())
+            rehash();
+    }
+
+    std::vector<Unit> entries;
+    std::vector<Unit> units;
+    std::vector<std::uint32_t> unitEntries;
+    const std::uint32_t generation;
+    const bool counted;
+    mutable std::atomic<unsigned int> references;
+
+private:
+    static void reset(SlotTable &table, std::size_t slotCount)
+    {
+        const Slot emptySlot = {0, QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT};
+        table.slots.assign(slotCount, emptySlot);
+        table.used = 0;
+    }
+
+    std::uint32_t find(const SlotTable &table, bool symbol, const char *text, std::size_t length) const
+    {
+        if(length == 0)
+            return QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT;
+
+        const std::uint32_t hash = hashOf(text, length);
+        const std::size_t mask = table.slots.size() - 1;
+
+        for(std::size_t i = hash & mask; table.slots[i].index != QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT; i = (i + 1) & mask)
+        {
+            const Slot &slot = table.slots[i];
+            if(slot.index == QUANTIFY_UNIT_REGISTRY_DELETED_SLOT || slot.hash != hash)
+                continue;
+
+            const std::string &key = keyOf(entries[slot.index], symbol);
+            if(key.size() == length && std::memcmp(key.data(), text, length) == 0)
+                return slot.index;
+        }
+
+        return QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT;
+    }
+
+    void insert(SlotTable &table, bool symbol, std::uint32_t index)
+    {
+        const std::string &key = keyOf(entries[index], symbol);
+        if(key.empty())
+            return;
+
+        const std::uint32_t hash = hashOf(key.data(), key.size());
+        const std::size_t mask = table.slots.size() - 1;
+
+        std::size_t i = hash & mask;
+        while(table.slots[i].index != QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT && table.slots[i].index != QUANTIFY_UNIT_REGISTRY_DELETED_SLOT)
+            i = (i + 1) & mask;
+
+        table.used += table.slots[i].index == QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT ? 1 : 0;
+        table.slots[i].hash = hash;
+        table.slots[i].index = index;
+    }
+
+    void erase(SlotTable &table, bool symbol, std::uint32_t index)
+    {
+        const std::string &key = keyOf(entries[index], symbol);
+        if(key.empty())
+            return;
+
+        const std::size_t mask = table.slots.size() - 1;
+        for(std::size_t i = hashOf(key.data(), key.size()) & mask; table.slots[i].index != QUANTIFY_UNIT_REGISTRY_EMPTY_SLOT; i = (i + 1) & mask)
+        {
+            if(table.slots[i].index == index)
+            {
+                table.slots[i].index = QUANTIFY_UNIT_REGISTRY_DELETED_SLOT;
+                return;
+            }
+        }
+    }
+
+    // slot of the dimensions, dimensionSlots.size() when not registered
+    std::size_t findDimensions(std::uint64_t packed) const
+    {
+        const std::size_t mask = dimensionSlots.size() - 1;
+
+        for(std::size_t i = (std::size_t) mix(packed) & mask; dimensionSlots[i].used; i = (i + 1) & mask)
+        {
+            if(dimensionSlots[i].packed == packed)
+                return i;
+        }
+
+        return dimensionSlots.size();
+    }
+
+    std::size_t insertDimensions(std::uint64_t packed)
+    {
+        if((usedDimensionSlots + 1) * 2 > dimensionSlots.size())
+            rehashDimensions();
+
+        const std::size_t mask = dimensionSlots.size() - 1;
+        std::size_t i = (std::size_t) mix(packed) & mask;
+        while(dimensionSlots[i].used)
+            i = (i + 1) & mask;
+
+        const DimensionSlot slot = {packed, (std::uint32_t) units.size(), 0, true};
+        dimensionSlots[i] = slot;
+        ++usedDimensionSlots;
+
+        return i;
+    }
+
+    // shifts the ranges starting at or after position, except the one of skip
+    void shiftRanges(std::uint32_t position, int offset, std::size_t skip)
+    {
+        for(std::size_t i=0; i<dimensionSlots.size(); ++i)
+        {
+            if(dimensionSlots[i].used && dimensionSlots[i].begin >= position && i != skip)
+                dimensionSlots[i].begin = (std::uint32_t) ((int) dimensionSlots[i].begin + offset);
+        }
+    }
+
+    // appends the entry to the range of its dimensions, new dimensions get
+    // a range at the end of the array
+    void insertIntoGroup(std::uint32_t index)
+    {
+        const std::uint64_t packed = entries[index].getDimensions().getPacked();
+
+        std::size_t group = findDimensions(packed);
+        if(group == dimensionSlots.size())
+            group = insertDimensions(packed);
+
+        const std::uint32_t position = dimensionSlots[group].begin + dimensionSlots[group].count;
+        units.insert(units.begin() + position, entries[index]);
+        unitEntries.insert(unitEntries.begin() + position, index);
+        shiftRanges(position, 1, group);
+        ++dimensionSlots[group].count;
+    }
+
+    void remove(std::uint32_t index)
+    {
+        erase(symbols, true, index);
+        erase(names, false, index);
+
+        const std::size_t group = findDimensions(entries[index].getDimensions().getPacked());
+        std::uint32_t position = dimensionSlots[group].begin;
+        while(unitEntries[position] != index)
+            ++position;
+
+        units.erase(units.begin() + position);
+        unitEntries.erase(unitEntries.begin() + position);
+        --dimensionSlots[group].count;
+        shiftRanges(position + 1, -1, group);
+
+        entries[index] = Unit();
+        ++deadEntries;
+    }
+
+    // also drops the dimensions left without units
+    void rehashDimensions()
+    {
+        std::vector<DimensionSlot> previous(slotCountFor(usedDimensionSlots + 1), DimensionSlot());
+        previous.swap(dimensionSlots);
+        usedDimensionSlots = 0;
+
+        const std::size_t mask = dimensionSlots.size() - 1;
+        for(const DimensionSlot &slot : previous)
+        {
+            if(!slot.used || slot.count == 0)
+                continue;
+
+            std::size_t i = (std::size_t) mix(slot.packed) & mask;
+            while(dimensionSlots[i].used)
+                i = (i + 1) & mask;
+
+            dimensionSlots[i] = slot;
+            ++usedDimensionSlots;
+        }
+    }
+
+    void rehash()
+    {
+        reset(symbols, slotCountFor(units.size()));
+        reset(names, slotCountFor(units.size()));
+
+        for(std::uint32_t index : unitEntries)
+        {
+            insert(symbols, true, index);
+            insert(names, false, index);
+        }
+    }
+
+    // drops the entries of replaced units, entries then follow the grouped order
+    void compact()
+    {
+        entries = units;
+        deadEntries = 0;
+        for(std::uint32_t i=0; i<unitEntries.size(); ++i)
+            unitEntries[i] = i;
+
+        rehash();
+    }
+
+    SlotTable symbols;
+    SlotTable names;
+    std::vector<DimensionSlot> dimensionSlots;
+    std::size_t usedDimensionSlots;
+    std::size_t deadEntries;
+};
+
+UnitRegistry::Range::Range()
+    : first(nullptr), last(nullptr)
+{
+
+}
+
+UnitRegistry::Range::Range(SnapshotPointer snapshot, const Unit *first, const Unit *last)
+    : snapshot(std::move(snapshot)), first(first), last(last)
+{
+
+}
+
+UnitRegistry::Range::Range(const Range &other) = default;
+UnitRegistry::Range::Range(Range &&other) noexcept = default;
+UnitRegistry::Range::~Range() noexcept = default;
+UnitRegistry::Range &UnitRegistry::Range::operator=(const Range &other) = default;
+UnitRegistry::Range &UnitRegistry::Range::operator=(Range &&other) noexcept = default;
+
+UnitRegistry::UnitRegistry()
+    : snapshot(new Snapshot()), epoch(0)
+{
+    for(ReaderCount &reader : readers)
+        reader.count.store(0, std::memory_order_relaxed);
+}
+
+UnitRegistry::~UnitRegistry() noexcept
+{
+    // ranges may still reference the published snapshot
+    SnapshotPointer published(snapshot.load(std::memory_order_relaxed));
+}
+
+UnitRegistry &UnitRegistry::getDefault()
+{
+    static UnitRegistry *instance = []()
+    {
+        UnitRegistry *registry = new UnitRegistry();
+        registry->addStandardUnits();
+        return registry;
+    }();
+
+    return *instance;
+}
+
+std::size_t UnitRegistry::getSnapshotCount()
+{
+    return snapshotCount.load(std::memory_order_relaxed);
+}
+
+void UnitRegistry::add(const Unit &unit)
+{
+    add(std::vector<Unit>(1, unit));
+}
+
+void UnitRegistry::add(const std::vector<Unit> &values)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const Snapshot *current = snapshot.load(std::memory_order_relaxed);
+    Snapshot *next = new Snapshot(*current);
+
+    try
+    {
+        for(const Unit &unit : values)
+            next->add(unit);
+    }
+    catch(...)
+    {
+        Snapshot::destroy(next);
+        throw;
+    }
+
+    snapshot.store(next);
+
+    // readers that entered before the swap may still use the previous
+    // snapshot, the registry's reference is released once they have all left
+    const std::uint32_t previousEpoch = epoch.load(std::memory_order_relaxed);
+    epoch.store(previousEpoch + 1);
+    waitForReaders(previousEpoch);
+
+    SnapshotPointer previous(current);
+}
+
+void UnitRegistry::addStandardUnits()
+{
+    const Unit *const *standardUnits = StandardUnits::AllUnits::getUnits();
+
+    std::vector<Unit> values;
+    values.reserve(StandardUnits::AllUnits::getCount());
+    for(std::size_t i=0; i<StandardUnits::AllUnits::getCount(); ++i)
+        values.push_back(*standardUnits[i]);
+
+    add(values);
+}
+
+bool UnitRegistry::findBySymbol(const char *symbol, std::size_t length, Unit &unit) const
+{
+    const std::size_t reader = enter();
+    const Unit *found = snapshot.load(std::memory_order_acquire)->findBySymbol(symbol, length);
+    if(found)
+        unit = *found;
+    leave(reader);
+
+    return found != nullptr;
+}
+
+bool UnitRegistry::findBySymbol(const std::string &symbol, Unit &unit) const
+{
+    return findBySymbol(symbol.data(), symbol.size(), unit);
+}
+
+bool UnitRegistry::findByName(const char *name, std::size_t length, Unit &unit) const
+{
+    const std::size_t reader = enter();
+    const Unit *found = snapshot.load(std::memory_order_acquire)->findByName(name, length);
+    if(found)
+        unit = *found;
+    leave(reader);
+
+    return found != nullptr;
+}
+
+bool UnitRegistry::findByName(const std::string &name, Unit &unit) const
+{
+    return findByName(name.data(), name.size(), unit);
+}
+
+UnitRegistry::Range UnitRegistry::findByDimensions(const Dimensions &dimensions) const
+{
+    const std::size_t reader = enter();
+    const Snapshot *current = snapshot.load(std::memory_order_acquire);
+
+    const Unit *first = nullptr;
+    const Unit *last = nullptr;
+    Range range;
+    if(current->findByDimensions(dimensions, first, last))
+        range = Range(current->share(), first, last);
+    leave(reader);
+
+    return range;
+}
+
+UnitRegistry::Range UnitRegistry::getUnits() const
+{
+    const std::size_t reader = enter();
+    const Snapshot *current = snapshot.load(std::memory_order_acquire);
+    Range range(current->share(), current->units.data(), current->units.data() + current->units.size());
+    leave(reader);
+
+    return range;
+}
+
+std::size_t UnitRegistry::size() const
+{
+    const std::size_t reader = enter();
+    const std::size_t size = snapshot.load(std::memory_order_acquire)->units.size();
+    leave(reader);
+
+    return size;
+}
+
+std::uint32_t UnitRegistry::getGeneration() const
+{
+    const std::size_t reader = enter();
+    const std::uint32_t generation = snapshot.load(std::memory_order_acquire)->generation;
+    leave(reader);
+
+    return generation;
+}
+
+// Registers the calling thread as a reader of the current epoch. The epoch is
+// checked again after the counter is incremented, so a writer that already
+// moved on either sees this reader or the reader sees the new snapshot.
+std::size_t UnitRegistry::enter() const
+{
+    const std::size_t stripe = readerStripe();
+
+    for(;;)
+    {
+        const std::uint32_t current = epoch.load();
+        const std::size_t reader = (current & 1) * QUANTIFY_UNIT_REGISTRY_READER_STRIPES + stripe;
+
+        readers[reader].count.fetch_add(1);
+        if(epoch.load() == current)
+            return reader;
+
+        readers[reader].count.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void UnitRegistry::leave(std::size_t reader) const
+{
+    readers[reader].count.fetch_sub(1, std::memory_order_release);
+}
+
+// readers entering after the epoch changed use the other counters, so the
+// counters of the previous epoch only drain
+void UnitRegistry::waitForReaders(std::uint32_t previousEpoch) const
+{
+    const ReaderCount *previous = readers + (previousEpoch & 1) * QUANTIFY_UNIT_REGISTRY_READER_STRIPES;
+
+    for(std::size_t i=0; i<QUANTIFY_UNIT_REGISTRY_READER_STRIPES; ++i)
+    {
+        while(previous[i].count.load() != 0)
+            std::this_thread::yield();
+    }
+}
+
+}
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/converter.h>
+#include <quantify/quantity.h>
+#include <quantify/standardunits.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+using namespace Quantify::StandardUnits;
+
+namespace {
+
+std::atomic<std::size_t> allocationCount(0);
+
+}
+
+// counting global allocator, only the number of allocations is tracked
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if(void *memory = std::malloc(size ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace Quantify {
+namespace Test {
+
+// Counts the heap allocations made between construction and getCount()
+class AllocationCounter
+{
+public:
+    AllocationCounter() : start(allocationCount.load(std::memory_order_relaxed)) {}
+
+    std::size_t getCount() const { return allocationCount.load(std::memory_order_relaxed) - start; }
+
+private:
+    std::size_t start;
+};
+
+TEST(AllocationTest, ValueTypes)
+{
+    static_assert(std::is_trivially_copyable<Dimensions>::value, "Dimensions must be trivially copyable");
+    static_assert(std::is_nothrow_copy_constructible<Unit>::value, "Unit copies must not throw");
+    static_assert(std::is_nothrow_move_constructible<Unit>::value, "Unit moves must not throw");
+    static_assert(std::is_nothrow_move_assignable<Unit>::value, "Unit moves must not throw");
+    static_assert(std::is_nothrow_copy_constructible<Quantity>::value, "Quantity copies must not throw");
+    static_assert(std::is_nothrow_move_constructible<Quantity>::value, "Quantity moves must not throw");
+    static_assert(std::is_nothrow_move_assignable<Quantity>::value, "Quantity moves must not throw");
+
+    Quantity moved(LengthUnits::foot, 2.0);
+    Quantity target(std::move(moved));
+
+    ASSERT_TRUE(target.getUnit() == LengthUnits::foot);
+    ASSERT_TRUE(moved.getUnit() == Unit());
+}
+
+TEST(AllocationTest, ArithmeticOnInternedUnits)
+{
+    const Quantity meters(LengthUnits::meter, 3.0);
+    const Quantity feet(LengthUnits::foot, 2.0);
+    const Quantity seconds(TimeUnits::second, 4.0);
+    const Quantity celsius(TemperatureUnits::degreeCelsius, 21.5);
+    Quantity result;
+
+    // first use interns the units and fills the composition cache
+    result = meters * seconds;
+    result = meters / seconds;
+    result = meters + feet;
+    result = celsius.convertTo(TemperatureUnits::kelvin);
+
+    AllocationCounter allocations;
+
+    result = meters + feet;
+    result = meters - feet;
+    result = meters * 2.0;
+    result = 2.0 * feet + meters;
+    result = meters * seconds;
+    result = meters / seconds;
+    result = feet.convertTo(LengthUnits::meter);
+    result = celsius.convertTo(TemperatureUnits::kelvin);
+    ASSERT_EQ(OperationStatus::Ok, meters.tryAdd(feet, result));
+    ASSERT_EQ(OperationStatus::IncompatibleUnits, meters.tryAdd(seconds, result));
+    ASSERT_TRUE(meters > feet);
+    ASSERT_TRUE(feet <= meters);
+    ASSERT_FALSE(meters == feet);
+
+    Quantity copy = result;
+    Quantity moved = std::move(copy);
+    Unit unit = moved.getUnit();
+    unit = LengthUnits::foot;
+
+    ASSERT_EQ(0u, allocations.getCount());
+}
+
+TEST(AllocationTest, Conversion)
+{
+    const double input[] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+    double output[9];
+
+    Converter converter(LengthUnits::foot, LengthUnits::meter);
+    converter.convert(input, output, 9);
+
+    AllocationCounter allocations;
+
+    Converter(LengthUnits::mile, LengthUnits::kilometer).convert(input, output, 9);
+    Converter(TemperatureUnits::degreeFahrenheit, TemperatureUnits::degreeCelsius).convert(input, output, 9);
+    Quantity::convert(LengthUnits::foot, LengthUnits::meter, input, output, 9);
+
+    ASSERT_EQ(0u, allocations.getCount());
+}
+
+}
+}
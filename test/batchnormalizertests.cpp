@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/batchnormalizer.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/standardunits.h>
+#include <vector>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+TEST(BatchNormalizerTest, MixedUnits)
+{
+    const Unit units[] = {LengthUnits::kilometer, LengthUnits::mile, LengthUnits::meter, LengthUnits::foot};
+
+    std::vector<Quantity> quantities;
+    for(int i=0; i<1000; ++i)
+        quantities.push_back(Quantity(units[(i * 7) % 4], 0.5 * i));
+
+    const QuantityArray meters = BatchNormalizer::normalize(quantities, LengthUnits::meter);
+    ASSERT_TRUE(meters.getUnit() == LengthUnits::meter);
+    ASSERT_EQ(quantities.size(), meters.size());
+    for(std::size_t i=0; i<quantities.size(); ++i)
+        ASSERT_DOUBLE_EQ(quantities[i].convertTo(LengthUnits::meter).getValue(), meters[i]);
+
+    const QuantityArray array(LengthUnits::foot, quantities);
+    for(std::size_t i=0; i<quantities.size(); ++i)
+        ASSERT_DOUBLE_EQ(quantities[i].convertTo(LengthUnits::foot).getValue(), array[i]);
+}
+
+TEST(BatchNormalizerTest, Offsets)
+{
+    const std::vector<Quantity> quantities = {Quantity(TemperatureUnits::degreeCelsius, 25.0), Quantity(TemperatureUnits::kelvin, 300.0),
+                                              Quantity(TemperatureUnits::degreeFahrenheit, 212.0), Quantity(TemperatureUnits::degreeCelsius, -273.15)};
+    double output[4];
+
+    BatchNormalizer::normalize(quantities.data(), quantities.size(), TemperatureUnits::kelvin, output);
+    ASSERT_DOUBLE_EQ(298.15, output[0]);
+    ASSERT_DOUBLE_EQ(300.0, output[1]);
+    ASSERT_DOUBLE_EQ(373.15, output[2]);
+    ASSERT_NEAR(0.0, output[3], 1e-12);
+}
+
+TEST(BatchNormalizerTest, SingleUnitAndEmpty)
+{
+    const std::vector<Quantity> quantities(5, Quantity(LengthUnits::kilometer, 2.0));
+    const QuantityArray meters = BatchNormalizer::normalize(quantities, LengthUnits::meter);
+
+    ASSERT_EQ(5u, meters.size());
+    for(double value : meters)
+        ASSERT_DOUBLE_EQ(2000.0, value);
+
+    ASSERT_TRUE(BatchNormalizer::normalize(std::vector<Quantity>(), LengthUnits::meter).empty());
+}
+
+TEST(BatchNormalizerTest, ManyUnits)
+{
+    std::vector<Quantity> quantities;
+    for(int i=1; i<=200; ++i)
+    {
+        const Unit unit("unit", "u", LengthUnits::meter.getDimensions(), (double) i);
+        quantities.push_back(Quantity(unit, 1.0));
+        quantities.push_back(Quantity(LengthUnits::meter, (double) i));
+    }
+
+    const QuantityArray meters = BatchNormalizer::normalize(quantities, LengthUnits::meter);
+    for(std::size_t i=0; i<quantities.size(); ++i)
+        ASSERT_DOUBLE_EQ((double) (i / 2 + 1), meters[i]);
+}
+
+TEST(BatchNormalizerTest, IncompatibleUnits)
+{
+    const std::vector<Quantity> quantities = {Quantity(LengthUnits::meter, 1.0), Quantity(TimeUnits::second, 2.0)};
+    double output[2] = {-1.0, -1.0};
+
+    ASSERT_THROW(BatchNormalizer::normalize(quantities.data(), quantities.size(), LengthUnits::meter, output), IncompatibleUnitsException);
+    ASSERT_EQ(-1.0, output[0]);
+    ASSERT_EQ(-1.0, output[1]);
+    ASSERT_THROW(QuantityArray(LengthUnits::meter, quantities), IncompatibleUnitsException);
+}
+
+}
+}
@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/compositioncache.h>
+#include <quantify/standardunits.h>
+#include <quantify/utils.h>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+class CompositionCacheTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        CompositionCache::clear();
+    }
+
+    virtual void TearDown()
+    {
+        CompositionCache::setCapacity(4096);
+    }
+};
+
+TEST_F(CompositionCacheTest, HitsAndMisses)
+{
+    Unit speed1 = LengthUnits::meter / TimeUnits::second;
+    CompositionCache::Statistics statistics1 = CompositionCache::getStatistics();
+
+    ASSERT_EQ(statistics1.hits, 0u);
+    ASSERT_EQ(statistics1.misses, 1u);
+    ASSERT_EQ(statistics1.size, 1u);
+
+    for(int i=0; i<100; ++i)
+    {
+        Unit speed2 = LengthUnits::meter / TimeUnits::second;
+        ASSERT_TRUE(speed1 == speed2);
+        ASSERT_STREQ("m/s", speed2.getSymbol().c_str());
+    }
+
+    CompositionCache::Statistics statistics2 = CompositionCache::getStatistics();
+    ASSERT_EQ(statistics2.hits, 100u);
+    ASSERT_EQ(statistics2.misses, 1u);
+    ASSERT_EQ(statistics2.size, 1u);
+}
+
+TEST_F(CompositionCacheTest, DistinguishesOperatorsAndLabels)
+{
+    Unit area = LengthUnits::meter * LengthUnits::meter;
+    Unit squared = LengthUnits::meter.power(2);
+    Unit cubed = LengthUnits::meter.power(3);
+    Unit ratio = LengthUnits::meter / LengthUnits::meter;
+
+    ASSERT_STREQ("m*m", area.getSymbol().c_str());
+    ASSERT_STREQ("m^2", squared.getSymbol().c_str());
+    ASSERT_STREQ("m^3", cubed.getSymbol().c_str());
+    ASSERT_STREQ("m/m", ratio.getSymbol().c_str());
+    ASSERT_TRUE(area == squared);
+
+    Unit metre("metre", "M", Dimensions(1));
+    Unit renamed = metre * metre;
+
+    ASSERT_TRUE(renamed == area);
+    ASSERT_STREQ("M*M", renamed.getSymbol().c_str());
+    ASSERT_EQ(CompositionCache::getStatistics().hits, 0u);
+}
+
+TEST_F(CompositionCacheTest, Bounded)
+{
+    CompositionCache::setCapacity(32);
+
+    for(int i=1; i<=200; ++i)
+    {
+        Unit scaled = (double) i * LengthUnits::meter;
+        Unit area = scaled * scaled;
+        ASSERT_TRUE(Utils::areClose(area.getFactor(), (double) (i * i), 1e-12));
+    }
+
+    CompositionCache::Statistics statistics = CompositionCache::getStatistics();
+    ASSERT_EQ(statistics.capacity, 32u);
+    ASSERT_LE(statistics.size, 32u);
+    ASSERT_EQ(statistics.misses, 200u);
+}
+
+}
+}
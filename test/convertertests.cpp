@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/converter.h>
+#include <quantify/quantity.h>
+#include <quantify/standardunits.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/utils.h>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+TEST(ConverterTest, Convert)
+{
+    Converter meterToFoot(LengthUnits::meter, LengthUnits::foot);
+    ASSERT_TRUE(Utils::areEqual(Utils::round(meterToFoot(1.0), 5), 3.28084));
+
+    Converter kelvinToCelsius(TemperatureUnits::kelvin, TemperatureUnits::degreeCelsius);
+    ASSERT_TRUE(Utils::areEqual(kelvinToCelsius(1.0), -272.15));
+
+    Converter celsiusToFahrenheit(TemperatureUnits::degreeCelsius, TemperatureUnits::degreeFahrenheit);
+    ASSERT_NEAR(celsiusToFahrenheit(-272.15), -457.87, 1e-10);
+    ASSERT_NEAR(celsiusToFahrenheit(100.0), 212.0, 1e-10);
+}
+
+TEST(ConverterTest, MatchesQuantityConvertTo)
+{
+    Converter converter(SpeedUnits::kilometerPerHour, SpeedUnits::milePerHour);
+    Quantity speed(SpeedUnits::kilometerPerHour, 120.0);
+
+    ASSERT_NEAR(converter(speed.getValue()), speed.convertTo(SpeedUnits::milePerHour).getValue(), 1e-12);
+
+    Quantity converted = converter(speed);
+    ASSERT_TRUE(converted.getUnit().getSymbol() == "mi/h");
+    ASSERT_NEAR(converted.getValue(), 74.5645430684801, 1e-10);
+
+    Quantity meters(LengthUnits::meter, 1000.0);
+    Converter kilometerToMeter(LengthUnits::kilometer, LengthUnits::meter);
+    ASSERT_NEAR(kilometerToMeter(meters).getValue(), 1000.0, 1e-12);
+}
+
+TEST(ConverterTest, Batch)
+{
+    Converter converter(TemperatureUnits::degreeCelsius, TemperatureUnits::kelvin);
+    std::vector<double> input = {0.0, 100.0, -273.15};
+    std::vector<double> output(input.size());
+
+    converter.convert(input.data(), output.data(), input.size());
+    ASSERT_NEAR(output[0], 273.15, 1e-12);
+    ASSERT_NEAR(output[1], 373.15, 1e-12);
+    ASSERT_NEAR(output[2], 0.0, 1e-12);
+
+    converter.convert(input.data(), input.size());
+    ASSERT_TRUE(input == output);
+
+    std::vector<double> kelvins = Converter(TemperatureUnits::kelvin, TemperatureUnits::degreeCelsius).convert(output);
+    ASSERT_NEAR(kelvins[1], 100.0, 1e-12);
+}
+
+TEST(ConverterTest, Identity)
+{
+    ASSERT_TRUE(Converter(LengthUnits::meter, LengthUnits::meter).isIdentity());
+    ASSERT_FALSE(Converter(LengthUnits::meter, LengthUnits::kilometer).isIdentity());
+}
+
+TEST(ConverterTest, Incompatible)
+{
+    bool exceptionOccured = false;
+    try
+    {
+        Converter converter(LengthUnits::meter, TimeUnits::second);
+    }
+    catch (IncompatibleUnitsException &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+}
+TEST(ConverterTest, ExactFactors)
+{
+    ASSERT_EQ(12.0, Converter(LengthUnits::foot, LengthUnits::inch).getScale());
+    ASSERT_EQ(63360000.0, Converter(LengthUnits::mile, LengthUnits::thou).getScale());
+    ASSERT_EQ(1.0, Converter(LengthUnits::kilometer / TimeUnits::hour, SpeedUnits::kilometerPerHour).getScale());
+    ASSERT_EQ(3.6, Converter(SpeedUnits::meterPerSecond, SpeedUnits::kilometerPerHour).getScale());
+
+    // folded through the composition, so the chain costs a single rounding
+    const Unit composed = (8.0 * (10.0 * (22.0 * (3.0 * (12.0 * LengthUnits::inch))))) / TimeUnits::hour;
+    ASSERT_EQ(SpeedUnits::milePerHour.getExactFactor(), composed.getExactFactor());
+    ASSERT_EQ(1.0, Converter(composed, SpeedUnits::milePerHour).getScale());
+}
+
+}
+}
@@ -24,6 +24,9 @@
 
 #include <gtest/gtest.h>
 #include <quantify/dimensions.h>
+#include <quantify/dimensionsoverflowexception.h>
+#include <type_traits>
+#include <unordered_set>
 
 namespace Quantify {
 namespace Test {
@@ -85,6 +88,90 @@ TEST_F(DimensionsTest, Power)
 
     ASSERT_TRUE(result2.equals(expected2));
 }
+TEST_F(DimensionsTest, NegativeExponents)
+{
+    Dimensions speed(1, 0, -1);
+    Dimensions force(1, 1, -2);
+
+    Dimensions result1 = force / speed;
+    ASSERT_TRUE(result1 == Dimensions(0, 1, -1));
+    ASSERT_EQ(result1.getTime(), -1);
+
+    Dimensions result2 = speed * speed.power(-1);
+    ASSERT_TRUE(result2 == Dimensions());
+
+    Dimensions result3 = Dimensions(0, 0, 0, 0, 0, 0, -3) * Dimensions(0, 0, 0, 0, 0, 0, 1);
+    ASSERT_EQ(result3.getLuminousIntensity(), -2);
+    ASSERT_EQ(result3.getAmountOfSubstance(), 0);
+}
+
+TEST_F(DimensionsTest, Setters)
+{
+    Dimensions dimensions(1, 2, 3);
+    dimensions.setMass(-4);
+    dimensions.setLuminousIntensity(7);
+
+    ASSERT_EQ(dimensions.getLength(), 1);
+    ASSERT_EQ(dimensions.getMass(), -4);
+    ASSERT_EQ(dimensions.getTime(), 3);
+    ASSERT_EQ(dimensions.getLuminousIntensity(), 7);
+    ASSERT_TRUE(dimensions == Dimensions(1, -4, 3, 0, 0, 0, 7));
+}
+
+TEST_F(DimensionsTest, Overflow)
+{
+    bool exceptionOccured = false;
+    try
+    {
+        Dimensions(100) * Dimensions(100);
+    }
+    catch (DimensionsOverflowException &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+
+    exceptionOccured = false;
+    try
+    {
+        Dimensions(0, -100) / Dimensions(0, 100);
+    }
+    catch (DimensionsOverflowException &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+
+    exceptionOccured = false;
+    try
+    {
+        Dimensions(0, 0, 2).power(64);
+    }
+    catch (DimensionsOverflowException &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+    ASSERT_TRUE(Dimensions(127) / Dimensions(1) == Dimensions(126));
+    ASSERT_TRUE(Dimensions(-127) * Dimensions(-1) == Dimensions(-128));
+}
+
+TEST_F(DimensionsTest, PackedAndHash)
+{
+    static_assert(sizeof(Dimensions) == 8, "Dimensions must fit in a 64 bit word");
+    static_assert(std::is_trivially_copyable<Dimensions>::value, "Dimensions must be trivially copyable");
+
+    constexpr Dimensions constant(1, 0, -2);
+    static_assert(constant.getTime() == -2, "Dimensions must be usable in constant expressions");
+
+    ASSERT_TRUE(Dimensions::fromPacked(d3.getPacked()) == d3);
+
+    std::unordered_set<Dimensions> set = {d1, d2, d3};
+    ASSERT_EQ(set.size(), 2u);
+}
 
 }
 }
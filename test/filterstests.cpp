@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/filters.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/standardunits.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+TEST(SelectionTest, Bits)
+{
+    Selection selection(130);
+    ASSERT_EQ(130u, selection.size());
+    ASSERT_EQ(3u, selection.getWords().size());
+    ASSERT_EQ(0u, selection.count());
+
+    selection.setSelected(0, true);
+    selection.setSelected(64, true);
+    selection.setSelected(129, true);
+    ASSERT_TRUE(selection[64]);
+    ASSERT_FALSE(selection[65]);
+    ASSERT_EQ(3u, selection.count());
+    ASSERT_EQ(std::vector<std::size_t>({0, 64, 129}), selection.toIndices());
+
+    selection.setSelected(64, false);
+    ASSERT_EQ(std::vector<std::size_t>({0, 129}), selection.toIndices());
+
+    const Selection all(130, true);
+    ASSERT_EQ(130u, all.count());
+    ASSERT_EQ(0u, (~all).count());
+    ASSERT_EQ(128u, (~selection).count());
+    ASSERT_TRUE((selection & all) == selection);
+    ASSERT_TRUE((selection | all) == all);
+    ASSERT_THROW(selection & Selection(129), std::length_error);
+}
+
+class FiltersTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        for(int i=0; i<200; ++i)
+            speeds.append(i * 0.5);
+        speeds.setUnit(SpeedUnits::kilometerPerHour);
+    }
+
+    Selection expected(bool (*predicate)(double)) const
+    {
+        Selection selection(speeds.size());
+        for(std::size_t i=0; i<speeds.size(); ++i)
+            selection.setSelected(i, predicate(speeds[i]));
+
+        return selection;
+    }
+
+    QuantityArray speeds;
+};
+
+TEST_F(FiltersTest, Thresholds)
+{
+    const Quantity threshold(SpeedUnits::meterPerSecond, 12.5);
+
+    ASSERT_TRUE(Filters::greaterThan(speeds, threshold) == expected([](double value) { return value > 45.0; }));
+    ASSERT_TRUE(Filters::greaterOrEqual(speeds, threshold) == expected([](double value) { return value >= 45.0; }));
+    ASSERT_TRUE(Filters::lessThan(speeds, threshold) == expected([](double value) { return value < 45.0; }));
+    ASSERT_TRUE(Filters::lessOrEqual(speeds, threshold) == expected([](double value) { return value <= 45.0; }));
+    ASSERT_TRUE(Filters::between(speeds, Quantity(SpeedUnits::meterPerSecond, 5.0), threshold) == expected([](double value) { return value >= 18.0 && value <= 45.0; }));
+
+    // same result as comparing quantities one by one
+    const Selection selection = Filters::greaterThan(speeds, threshold);
+    for(std::size_t i=0; i<speeds.size(); ++i)
+        ASSERT_EQ(speeds.at(i) > threshold, selection[i]) << i;
+
+    ASSERT_THROW(Filters::greaterThan(speeds, Quantity(TimeUnits::second, 1.0)), IncompatibleUnitsException);
+}
+
+TEST_F(FiltersTest, InfiniteThresholds)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    QuantityArray values(LengthUnits::meter, std::vector<double>({-infinity, -1.0, 0.0, 1.0, infinity}));
+
+    ASSERT_EQ(0u, Filters::greaterThan(values, Quantity(LengthUnits::meter, infinity)).count());
+    ASSERT_EQ(0u, Filters::lessThan(values, Quantity(LengthUnits::meter, -infinity)).count());
+    ASSERT_EQ(std::vector<std::size_t>({4}), Filters::greaterOrEqual(values, Quantity(LengthUnits::meter, infinity)).toIndices());
+    ASSERT_EQ(std::vector<std::size_t>({0}), Filters::lessOrEqual(values, Quantity(LengthUnits::meter, -infinity)).toIndices());
+    ASSERT_EQ(std::vector<std::size_t>({0, 1, 2, 3}), Filters::lessThan(values, Quantity(LengthUnits::meter, infinity)).toIndices());
+    ASSERT_EQ(std::vector<std::size_t>({1, 2, 3, 4}), Filters::greaterThan(values, Quantity(LengthUnits::meter, -infinity)).toIndices());
+}
+
+TEST_F(FiltersTest, Equals)
+{
+    ASSERT_EQ(std::vector<std::size_t>({90}), Filters::equals(speeds, Quantity(SpeedUnits::meterPerSecond, 12.5)).toIndices());
+    ASSERT_EQ(std::vector<std::size_t>({89, 90, 91}), Filters::equals(speeds, Quantity(SpeedUnits::kilometerPerHour, 45.0), Quantity(SpeedUnits::kilometerPerHour, 0.5)).toIndices());
+    ASSERT_EQ(0u, Filters::equals(speeds, Quantity(SpeedUnits::kilometerPerHour, 45.1)).count());
+    ASSERT_EQ(0u, Filters::equals(speeds, Quantity(SpeedUnits::kilometerPerHour, std::numeric_limits<double>::infinity())).count());
+
+    // tolerances are differences, the offset of their unit does not apply
+    QuantityArray temperatures(TemperatureUnits::degreeCelsius, std::vector<double>({19.0, 20.5, 21.5, 22.5}));
+    ASSERT_EQ(std::vector<std::size_t>({1, 2}), Filters::equals(temperatures, Quantity(TemperatureUnits::kelvin, 294.15), Quantity(TemperatureUnits::kelvin, 1.0)).toIndices());
+
+    // values close to zero, where the default tolerance spans several doubles
+    QuantityArray small(LengthUnits::meter, std::vector<double>({1e-17, 2e-16, 3e-16, -1e-16}));
+    for(std::size_t i=0; i<small.size(); ++i)
+        ASSERT_EQ(small.at(i) == Quantity(LengthUnits::meter, 1e-16), Filters::equals(small, Quantity(LengthUnits::meter, 1e-16))[i]) << i;
+}
+
+TEST_F(FiltersTest, CombineColumns)
+{
+    QuantityArray temperatures(TemperatureUnits::degreeFahrenheit, speeds.size());
+    for(std::size_t i=0; i<temperatures.size(); ++i)
+        temperatures[i] = (i % 2) ? 50.0 : 100.0;
+
+    const Selection fastAndHot = Filters::greaterThan(speeds, Quantity(SpeedUnits::kilometerPerHour, 90.0)) & Filters::greaterThan(temperatures, Quantity(TemperatureUnits::degreeCelsius, 30.0));
+    const Selection slowOrCold = Filters::lessThan(speeds, Quantity(SpeedUnits::kilometerPerHour, 1.0)) | Filters::lessThan(temperatures, Quantity(TemperatureUnits::degreeCelsius, 30.0));
+
+    ASSERT_EQ(std::vector<std::size_t>({182, 184, 186, 188, 190, 192, 194, 196, 198}), fastAndHot.toIndices());
+    ASSERT_EQ(101u, slowOrCold.count());
+    ASSERT_TRUE(slowOrCold[0]);
+    ASSERT_TRUE(slowOrCold[1]);
+    ASSERT_FALSE(slowOrCold[2]);
+}
+
+}
+}
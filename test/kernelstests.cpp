@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/kernels.h>
+#include <quantify/quantity.h>
+#include <quantify/standardunits.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+class KernelsTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        for(int i=0; i<1027; ++i)
+            values.push_back(i * 0.37 - 150.0);
+    }
+
+    virtual void TearDown()
+    {
+        Kernels::setInstructionSet(Kernels::getSupportedInstructionSet());
+    }
+
+    std::vector<double> values;
+};
+
+TEST_F(KernelsTest, AffineAllInstructionSets)
+{
+    const Kernels::InstructionSet instructionSets[] = {Kernels::InstructionSet::Scalar, Kernels::InstructionSet::SSE2,
+                                                       Kernels::InstructionSet::AVX2, Kernels::InstructionSet::AVX512};
+
+    for(Kernels::InstructionSet instructionSet : instructionSets)
+    {
+        Kernels::setInstructionSet(instructionSet);
+        ASSERT_LE((int) Kernels::getInstructionSet(), (int) Kernels::getSupportedInstructionSet());
+
+        for(std::size_t count : {0, 1, 7, 8, 9, 15, 16, 17, 1027})
+        {
+            std::vector<double> output(count + 1, -1.0);
+            Kernels::affine(values.data(), output.data(), count, 1.8, 32.0);
+
+            // fused and separate rounding agree within one ulp of the largest
+            // of the product, the bias and the result
+            for(std::size_t i=0; i<count; ++i)
+            {
+                const double expected = std::fma(values[i], 1.8, 32.0);
+                const double term = std::max(std::max(std::fabs(values[i] * 1.8), 32.0), std::fabs(expected));
+                const double ulp = std::nextafter(term, std::numeric_limits<double>::infinity()) - term;
+                ASSERT_LE(std::fabs(output[i] - expected), ulp) << Kernels::getInstructionSetName(instructionSet) << " " << i;
+            }
+
+            ASSERT_EQ(output[count], -1.0);
+        }
+    }
+}
+
+TEST_F(KernelsTest, SelectRangeAllInstructionSets)
+{
+    const Kernels::InstructionSet instructionSets[] = {Kernels::InstructionSet::Scalar, Kernels::InstructionSet::SSE2,
+                                                       Kernels::InstructionSet::AVX2, Kernels::InstructionSet::AVX512};
+    values[5] = std::numeric_limits<double>::quiet_NaN();
+    values[70] = -10.0;
+    values[71] = 20.0;
+
+    for(Kernels::InstructionSet instructionSet : instructionSets)
+    {
+        Kernels::setInstructionSet(instructionSet);
+
+        for(std::size_t count : {0, 1, 7, 63, 64, 65, 128, 1027})
+        {
+            const std::size_t words = (count + 63) / 64;
+            std::vector<std::uint64_t> bitmap(words + 1, 0xAAAAAAAAAAAAAAAAULL);
+            Kernels::selectRange(values.data(), count, -10.0, 20.0, bitmap.data());
+
+            for(std::size_t i=0; i<words * 64; ++i)
+            {
+                const bool expected = i < count && values[i] >= -10.0 && values[i] <= 20.0;
+                ASSERT_EQ(expected, ((bitmap[i / 64] >> (i % 64)) & 1) != 0) << Kernels::getInstructionSetName(instructionSet) << " " << i;
+            }
+
+            ASSERT_EQ(bitmap[words], 0xAAAAAAAAAAAAAAAAULL);
+        }
+    }
+}
+
+TEST_F(KernelsTest, QuantityBatchConvert)
+{
+    std::vector<double> fahrenheits(values.size());
+    Quantity::convert(TemperatureUnits::degreeCelsius, TemperatureUnits::degreeFahrenheit, values.data(), fahrenheits.data(), values.size());
+
+    for(std::size_t i=0; i<values.size(); ++i)
+    {
+        double expected = Quantity(TemperatureUnits::degreeCelsius, values[i]).convertTo(TemperatureUnits::degreeFahrenheit).getValue();
+        ASSERT_NEAR(fahrenheits[i], expected, 1e-9);
+    }
+
+    Quantity::convert(TemperatureUnits::degreeFahrenheit, TemperatureUnits::degreeCelsius, fahrenheits.data(), fahrenheits.size());
+
+    for(std::size_t i=0; i<values.size(); ++i)
+        ASSERT_NEAR(fahrenheits[i], values[i], 1e-9);
+}
+
+}
+}
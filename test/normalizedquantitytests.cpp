@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/normalizedquantity.h>
+#include <quantify/standardunits.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+TEST(NormalizedQuantityTest, Normalize)
+{
+    ASSERT_DOUBLE_EQ(1000.0, NormalizedQuantity(LengthUnits::kilometer, 1.0).getNormalizedValue());
+    ASSERT_DOUBLE_EQ(294.65, NormalizedQuantity(TemperatureUnits::degreeCelsius, 21.5).getNormalizedValue());
+    ASSERT_DOUBLE_EQ(10.0, NormalizedQuantity(SpeedUnits::kilometerPerHour, 36.0).getNormalizedValue());
+    ASSERT_DOUBLE_EQ(1.0 / 3.0, NormalizedQuantity(Unit("third", "t", Dimensions(), 1.0 / 3.0), 1.0).getNormalizedValue());
+
+    const NormalizedQuantity foot(Quantity(LengthUnits::foot, 2.0));
+    ASSERT_TRUE(foot.getUnit() == LengthUnits::foot);
+    ASSERT_EQ(2.0, foot.getValue());
+}
+
+TEST(NormalizedQuantityTest, Compare)
+{
+    // rounded once from the exact factors, so these are equal doubles
+    ASSERT_TRUE(NormalizedQuantity(LengthUnits::foot, 3.0) == NormalizedQuantity(LengthUnits::yard, 1.0));
+    ASSERT_TRUE(NormalizedQuantity(LengthUnits::inch, 12.0) == NormalizedQuantity(LengthUnits::foot, 1.0));
+    ASSERT_TRUE(NormalizedQuantity(LengthUnits::foot, 5280.0) == NormalizedQuantity(LengthUnits::mile, 1.0));
+
+    const NormalizedQuantity meter(LengthUnits::meter, 1.0);
+    const NormalizedQuantity foot(LengthUnits::foot, 1.0);
+
+    ASSERT_EQ(Ordering::Greater, meter.compare(foot));
+    ASSERT_EQ(Ordering::Less, foot.compare(meter));
+    ASSERT_EQ(Ordering::Equal, meter.compare(NormalizedQuantity(LengthUnits::centimeter, 100.0)));
+    ASSERT_TRUE(foot < meter);
+    ASSERT_TRUE(foot <= meter);
+    ASSERT_TRUE(meter >= foot);
+    ASSERT_TRUE(meter > foot);
+    ASSERT_TRUE(meter != foot);
+
+    const NormalizedQuantity nan(LengthUnits::meter, std::numeric_limits<double>::quiet_NaN());
+    ASSERT_EQ(Ordering::Unordered, nan.compare(meter));
+    ASSERT_FALSE(nan <= meter);
+    ASSERT_FALSE(nan >= meter);
+
+    ASSERT_THROW(meter.compare(NormalizedQuantity(TimeUnits::second, 1.0)), IncompatibleUnitsException);
+    ASSERT_THROW(meter < NormalizedQuantity(TimeUnits::second, 1.0), IncompatibleUnitsException);
+}
+
+TEST(NormalizedQuantityTest, SortAndHash)
+{
+    std::vector<NormalizedQuantity> lengths = {
+        NormalizedQuantity(LengthUnits::kilometer, 1.0),
+        NormalizedQuantity(LengthUnits::foot, 1.0),
+        NormalizedQuantity(LengthUnits::mile, 1.0),
+        NormalizedQuantity(LengthUnits::meter, 1.0),
+        NormalizedQuantity(LengthUnits::yard, 1.0)
+    };
+
+    std::sort(lengths.begin(), lengths.end());
+
+    ASSERT_TRUE(lengths.front().getUnit() == LengthUnits::foot);
+    ASSERT_TRUE(lengths[1].getUnit() == LengthUnits::yard);
+    ASSERT_TRUE(lengths.back().getUnit() == LengthUnits::mile);
+    ASSERT_TRUE(std::max(lengths[2], lengths[3]).getUnit() == LengthUnits::kilometer);
+
+    std::unordered_set<NormalizedQuantity> unique(lengths.begin(), lengths.end());
+    unique.insert(NormalizedQuantity(LengthUnits::foot, 3.0));
+    unique.insert(NormalizedQuantity(LengthUnits::centimeter, 100.0));
+    unique.insert(NormalizedQuantity(TimeUnits::second, 1.0));
+
+    ASSERT_EQ(6u, unique.size());
+}
+
+}
+}
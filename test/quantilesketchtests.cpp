@@ -0,0 +1,203 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/quantilesketch.h>
+#include <quantify/quantilesketchformatexception.h>
+#include <quantify/standardunits.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+// deterministic pseudo random values in [0, 1)
+static std::vector<double> makeUniform(std::size_t count)
+{
+    std::vector<double> values;
+    std::uint64_t state = 42;
+    for(std::size_t i=0; i<count; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        values.push_back((double) (state >> 11) / 9007199254740992.0);
+    }
+
+    return values;
+}
+
+static double exactQuantile(std::vector<double> values, double q)
+{
+    std::sort(values.begin(), values.end());
+    return values[(std::size_t) (q * (values.size() - 1))];
+}
+
+// fraction of the sorted values below value
+static double rank(const std::vector<double> &values, double value)
+{
+    return (double) (std::lower_bound(values.begin(), values.end(), value) - values.begin()) / values.size();
+}
+
+TEST(QuantileSketchTest, Quantiles)
+{
+    const std::vector<double> values = makeUniform(100000);
+    std::vector<double> latencies;
+    QuantileSketch sketch(TimeUnits::millisecond);
+
+    for(double value : values)
+    {
+        // long tailed, in mixed units
+        const double latency = -std::log(1.0 - value) * 20.0;
+        latencies.push_back(latency);
+        sketch.add(latencies.size() % 2 ? Quantity(TimeUnits::millisecond, latency) : Quantity(TimeUnits::second, latency / 1000.0));
+    }
+
+    ASSERT_EQ(values.size(), sketch.getCount());
+    ASSERT_LE(sketch.getCentroidCount(), (std::size_t) QUANTIFY_QUANTILE_SKETCH_COMPRESSION);
+    ASSERT_TRUE(sketch.quantile(0.5).getUnit() == TimeUnits::millisecond);
+
+    // t-digest bounds the rank error, tighter at the tails
+    std::sort(latencies.begin(), latencies.end());
+    for(double q : {0.001, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999})
+        ASSERT_NEAR(q, rank(latencies, sketch.quantile(q).getValue()), 0.02 * std::sqrt(q * (1.0 - q))) << "q = " << q;
+
+    ASSERT_DOUBLE_EQ(latencies.front(), sketch.getMin().getValue());
+    ASSERT_DOUBLE_EQ(latencies.back(), sketch.getMax().getValue());
+    ASSERT_DOUBLE_EQ(sketch.quantile(0.99).getValue() / 1000.0, sketch.quantile(0.99, TimeUnits::second).getValue());
+    ASSERT_THROW(sketch.quantile(0.5, LengthUnits::meter), IncompatibleUnitsException);
+    ASSERT_THROW(sketch.add(Quantity(LengthUnits::meter, 1.0)), IncompatibleUnitsException);
+}
+
+TEST(QuantileSketchTest, Offsets)
+{
+    QuantileSketch sketch(TemperatureUnits::degreeCelsius);
+    for(int i=0; i<=100; ++i)
+        sketch.add(Quantity(TemperatureUnits::kelvin, 273.15 + i));
+
+    ASSERT_NEAR(50.0, sketch.quantile(0.5).getValue(), 1e-9);
+    ASSERT_NEAR(323.15, sketch.quantile(0.5, TemperatureUnits::kelvin).getValue(), 1e-9);
+    ASSERT_NEAR(0.0, sketch.getMin().getValue(), 1e-9);
+    ASSERT_NEAR(100.0, sketch.getMax().getValue(), 1e-9);
+}
+
+TEST(QuantileSketchTest, Empty)
+{
+    QuantileSketch sketch(LengthUnits::meter);
+    ASSERT_EQ(0u, sketch.getCount());
+    ASSERT_TRUE(std::isnan(sketch.quantile(0.5).getValue()));
+    ASSERT_TRUE(std::isnan(sketch.getMin().getValue()));
+
+    sketch.add(Quantity(LengthUnits::meter, std::numeric_limits<double>::quiet_NaN()));
+    ASSERT_EQ(0u, sketch.getCount());
+
+    sketch.add(Quantity(LengthUnits::kilometer, 2.0));
+    ASSERT_EQ(1u, sketch.getCount());
+    ASSERT_DOUBLE_EQ(2000.0, sketch.quantile(0.5).getValue());
+
+    sketch.clear();
+    ASSERT_EQ(0u, sketch.getCount());
+    for(double compression : {0.0, -1.0, 1e300, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()})
+        ASSERT_THROW(QuantileSketch(LengthUnits::meter, compression), std::invalid_argument) << compression;
+}
+
+TEST(QuantileSketchTest, NonFiniteValues)
+{
+    QuantileSketch sketch(LengthUnits::meter);
+    for(int i=0; i<2000; ++i)
+    {
+        sketch.add(Quantity(LengthUnits::meter, std::numeric_limits<double>::infinity()));
+        sketch.add(Quantity(LengthUnits::meter, -std::numeric_limits<double>::infinity()));
+        sketch.add(Quantity(LengthUnits::meter, (double) i));
+    }
+
+    ASSERT_EQ(2000u, sketch.getCount());
+    ASSERT_DOUBLE_EQ(0.0, sketch.getMin().getValue());
+    ASSERT_DOUBLE_EQ(1999.0, sketch.getMax().getValue());
+    for(double q : {0.01, 0.5, 0.99})
+        ASSERT_TRUE(std::isfinite(sketch.quantile(q).getValue())) << "q = " << q;
+}
+
+TEST(QuantileSketchTest, Merge)
+{
+    const std::vector<double> values = makeUniform(40000);
+    QuantileSketch all(LengthUnits::meter);
+    QuantileSketch parts[4] = {QuantileSketch(LengthUnits::meter), QuantileSketch(LengthUnits::kilometer), QuantileSketch(LengthUnits::foot), QuantileSketch(LengthUnits::meter)};
+
+    for(std::size_t i=0; i<values.size(); ++i)
+    {
+        const Quantity quantity(LengthUnits::meter, values[i] * 1000.0);
+        all.add(quantity);
+        parts[i % 4].add(quantity);
+    }
+
+    QuantileSketch merged(LengthUnits::meter);
+    for(const QuantileSketch &part : parts)
+        merged.merge(part);
+
+    ASSERT_EQ(all.getCount(), merged.getCount());
+    ASSERT_LE(merged.getCentroidCount(), (std::size_t) QUANTIFY_QUANTILE_SKETCH_COMPRESSION);
+    for(double q : {0.01, 0.5, 0.99})
+        ASSERT_NEAR(exactQuantile(values, q) * 1000.0, merged.quantile(q).getValue(), 5.0) << "q = " << q;
+    ASSERT_DOUBLE_EQ(all.getMin().getValue(), merged.getMin().getValue());
+    ASSERT_DOUBLE_EQ(all.getMax().getValue(), merged.getMax().getValue());
+
+    ASSERT_THROW(merged.merge(QuantileSketch(TimeUnits::second)), IncompatibleUnitsException);
+}
+
+TEST(QuantileSketchTest, Serialize)
+{
+    QuantileSketch sketch(SpeedUnits::kilometerPerHour);
+    for(double value : makeUniform(10000))
+        sketch.add(Quantity(SpeedUnits::kilometerPerHour, value * 130.0));
+
+    const std::string data = sketch.serialize();
+    ASSERT_LE(data.size(), 48 + 10 * sketch.getCentroidCount());
+
+    const QuantileSketch restored = QuantileSketch::deserialize(data, SpeedUnits::meterPerSecond);
+    ASSERT_EQ(sketch.getCount(), restored.getCount());
+    ASSERT_EQ(sketch.getCentroidCount(), restored.getCentroidCount());
+    for(double q : {0.0, 0.25, 0.5, 0.99, 1.0})
+        ASSERT_EQ(sketch.quantile(q, SpeedUnits::meterPerSecond).getValue(), restored.quantile(q).getValue());
+    ASSERT_EQ(data, restored.serialize());
+
+    ASSERT_EQ(0u, QuantileSketch::deserialize(QuantileSketch(LengthUnits::meter).serialize(), LengthUnits::foot).getCount());
+    ASSERT_THROW(QuantileSketch::deserialize(data, LengthUnits::meter), IncompatibleUnitsException);
+    ASSERT_THROW(QuantileSketch::deserialize(data.substr(0, data.size() - 3), SpeedUnits::meterPerSecond), QuantileSketchFormatException);
+    ASSERT_THROW(QuantileSketch::deserialize(data + "x", SpeedUnits::meterPerSecond), QuantileSketchFormatException);
+    ASSERT_THROW(QuantileSketch::deserialize(std::string(), SpeedUnits::meterPerSecond), QuantileSketchFormatException);
+    ASSERT_THROW(QuantileSketch::deserialize(std::string(1, '\x7F') + data.substr(1), SpeedUnits::meterPerSecond), QuantileSketchFormatException);
+
+    // min and max follow the version byte, the dimensions and the compression
+    const std::string nan("\x00\x00\x00\x00\x00\x00\xF8\x7F", 8);
+    ASSERT_THROW(QuantileSketch::deserialize(data.substr(0, 17) + nan + data.substr(25), SpeedUnits::meterPerSecond), QuantileSketchFormatException);
+    ASSERT_THROW(QuantileSketch::deserialize(data.substr(0, 25) + nan + data.substr(33), SpeedUnits::meterPerSecond), QuantileSketchFormatException);
+}
+
+}
+}
@@ -0,0 +1,176 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/quantityaccumulator.h>
+#include <quantify/standardunits.h>
+#include <cmath>
+#include <vector>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+TEST(QuantityAccumulatorTest, Add)
+{
+    QuantityAccumulator accumulator(LengthUnits::meter);
+    accumulator.add(Quantity(LengthUnits::meter, 2.0));
+    accumulator.add(Quantity(LengthUnits::centimeter, 400.0));
+    accumulator.add(Quantity(LengthUnits::kilometer, 0.006));
+
+    ASSERT_EQ(3u, accumulator.getCount());
+    ASSERT_TRUE(accumulator.getUnit() == LengthUnits::meter);
+    ASSERT_DOUBLE_EQ(12.0, accumulator.getSum().getValue());
+    ASSERT_DOUBLE_EQ(4.0, accumulator.getMean().getValue());
+    ASSERT_DOUBLE_EQ(2.0, accumulator.getMin().getValue());
+    ASSERT_DOUBLE_EQ(6.0, accumulator.getMax().getValue());
+    ASSERT_DOUBLE_EQ(8.0 / 3.0, accumulator.getVariance().getValue());
+    ASSERT_TRUE(accumulator.getVariance().getUnit() == LengthUnits::meter.power(2));
+    ASSERT_DOUBLE_EQ(std::sqrt(8.0 / 3.0), accumulator.getStandardDeviation().getValue());
+
+    ASSERT_THROW(accumulator.add(Quantity(TimeUnits::second, 1.0)), IncompatibleUnitsException);
+    ASSERT_EQ(3u, accumulator.getCount());
+
+    accumulator.clear();
+    ASSERT_EQ(0u, accumulator.getCount());
+    ASSERT_EQ(0.0, accumulator.getSum().getValue());
+    ASSERT_TRUE(std::isnan(accumulator.getMean().getValue()));
+    ASSERT_TRUE(std::isnan(accumulator.getMin().getValue()));
+    ASSERT_TRUE(std::isnan(accumulator.getVariance().getValue()));
+}
+
+TEST(QuantityAccumulatorTest, ManyUnits)
+{
+    // more distinct units than cached conversions
+    const Unit units[] = {LengthUnits::meter, LengthUnits::kilometer, LengthUnits::foot, LengthUnits::inch, LengthUnits::mile, LengthUnits::centimeter};
+
+    QuantityAccumulator accumulator(LengthUnits::meter);
+    double sum = 0.0;
+    for(int i=0; i<600; ++i)
+    {
+        const Quantity quantity(units[(i * 5) % 6], (double) i);
+        accumulator.add(quantity);
+        sum += quantity.convertTo(LengthUnits::meter).getValue();
+    }
+
+    ASSERT_EQ(600u, accumulator.getCount());
+    ASSERT_NEAR(sum, accumulator.getSum().getValue(), 1e-12 * sum);
+}
+
+TEST(QuantityAccumulatorTest, Batches)
+{
+    std::vector<Quantity> quantities;
+    QuantityAccumulator single(TemperatureUnits::kelvin);
+    for(int i=0; i<1000; ++i)
+    {
+        quantities.push_back(Quantity(i % 2 ? TemperatureUnits::degreeCelsius : TemperatureUnits::kelvin, 0.25 * i));
+        single.add(quantities.back());
+    }
+
+    QuantityAccumulator batch(TemperatureUnits::kelvin);
+    batch.add(quantities);
+    ASSERT_EQ(single.getCount(), batch.getCount());
+    ASSERT_DOUBLE_EQ(single.getSum().getValue(), batch.getSum().getValue());
+    ASSERT_NEAR(single.getVariance().getValue(), batch.getVariance().getValue(), 1e-12 * single.getVariance().getValue());
+    ASSERT_EQ(single.getMin().getValue(), batch.getMin().getValue());
+    ASSERT_EQ(single.getMax().getValue(), batch.getMax().getValue());
+
+    QuantityAccumulator array(TemperatureUnits::kelvin);
+    array.add(QuantityArray(TemperatureUnits::degreeCelsius, std::vector<double>(600, 25.0)));
+    array.add(QuantityArray(TemperatureUnits::kelvin, std::vector<double>(400, 298.15)));
+    ASSERT_EQ(1000u, array.getCount());
+    ASSERT_DOUBLE_EQ(298150.0, array.getSum().getValue());
+    ASSERT_NEAR(0.0, array.getVariance().getValue(), 1e-9);
+}
+
+TEST(QuantityAccumulatorTest, Merge)
+{
+    QuantityAccumulator all(LengthUnits::meter);
+    QuantityAccumulator parts[3] = {QuantityAccumulator(LengthUnits::meter), QuantityAccumulator(LengthUnits::meter), QuantityAccumulator(LengthUnits::meter)};
+    for(int i=0; i<300; ++i)
+    {
+        const Quantity quantity(LengthUnits::meter, std::sin(0.1 * i) * 100.0 + i);
+        all.add(quantity);
+        parts[i % 3].add(quantity);
+    }
+
+    QuantityAccumulator left(LengthUnits::meter);
+    left.merge(parts[0]);
+    left.merge(parts[1]);
+    left.merge(parts[2]);
+
+    QuantityAccumulator right(LengthUnits::meter);
+    QuantityAccumulator tail = parts[1];
+    tail.merge(parts[2]);
+    right.merge(parts[0]);
+    right.merge(tail);
+
+    for(const QuantityAccumulator *merged : {&left, &right})
+    {
+        ASSERT_EQ(all.getCount(), merged->getCount());
+        ASSERT_DOUBLE_EQ(all.getSum().getValue(), merged->getSum().getValue());
+        ASSERT_DOUBLE_EQ(all.getMean().getValue(), merged->getMean().getValue());
+        ASSERT_DOUBLE_EQ(all.getVariance().getValue(), merged->getVariance().getValue());
+        ASSERT_EQ(all.getMin().getValue(), merged->getMin().getValue());
+        ASSERT_EQ(all.getMax().getValue(), merged->getMax().getValue());
+    }
+
+    QuantityAccumulator empty;
+    left.merge(empty);
+    ASSERT_EQ(all.getCount(), left.getCount());
+}
+
+TEST(QuantityAccumulatorTest, MergeOtherUnit)
+{
+    QuantityAccumulator meters(LengthUnits::meter);
+    meters.add(Quantity(LengthUnits::meter, 1.0));
+
+    QuantityAccumulator centimeters(LengthUnits::centimeter);
+    centimeters.add(Quantity(LengthUnits::centimeter, 200.0));
+    centimeters.add(Quantity(LengthUnits::centimeter, 300.0));
+
+    meters.merge(centimeters);
+    ASSERT_EQ(3u, meters.getCount());
+    ASSERT_DOUBLE_EQ(6.0, meters.getSum().getValue());
+    ASSERT_DOUBLE_EQ(1.0, meters.getMin().getValue());
+    ASSERT_DOUBLE_EQ(3.0, meters.getMax().getValue());
+    ASSERT_DOUBLE_EQ(2.0 / 3.0, meters.getVariance().getValue());
+
+    QuantityAccumulator celsius(TemperatureUnits::degreeCelsius);
+    celsius.add(Quantity(TemperatureUnits::degreeCelsius, 10.0));
+    QuantityAccumulator kelvin(TemperatureUnits::kelvin);
+    kelvin.add(Quantity(TemperatureUnits::kelvin, 303.15));
+    celsius.merge(kelvin);
+    ASSERT_DOUBLE_EQ(20.0, celsius.getMean().getValue());
+    ASSERT_DOUBLE_EQ(40.0, celsius.getSum().getValue());
+
+    QuantityAccumulator seconds(TimeUnits::second);
+    seconds.add(1.0);
+    ASSERT_THROW(meters.merge(seconds), IncompatibleUnitsException);
+}
+
+}
+}
@@ -0,0 +1,159 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/quantityarray.h>
+#include <quantify/standardunits.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/unitunsupportedoperationexception.h>
+#include <stdexcept>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+class QuantityArrayTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        meters = QuantityArray(LengthUnits::meter, {1.0, 2.0, 3.0});
+        feet = QuantityArray(LengthUnits::foot, {1.0, 2.0, 3.0});
+        seconds = QuantityArray(TimeUnits::second, {2.0, 4.0, 6.0});
+    }
+
+    QuantityArray meters;
+    QuantityArray feet;
+    QuantityArray seconds;
+};
+
+TEST_F(QuantityArrayTest, Construct)
+{
+    std::vector<Quantity> quantities = {Quantity(LengthUnits::meter, 1.0), Quantity(LengthUnits::kilometer, 1.0)};
+    QuantityArray array(LengthUnits::meter, quantities);
+
+    ASSERT_EQ(array.size(), 2u);
+    ASSERT_DOUBLE_EQ(array[1], 1000.0);
+    ASSERT_TRUE(array.at(1) == Quantity(LengthUnits::kilometer, 1.0));
+
+    array.append(Quantity(LengthUnits::foot, 1.0));
+    ASSERT_DOUBLE_EQ(array[2], 0.3048);
+
+    std::vector<Quantity> back = array.toQuantities();
+    ASSERT_EQ(back.size(), 3u);
+    ASSERT_TRUE(back[2].getUnit().getSymbol() == "m");
+}
+
+TEST_F(QuantityArrayTest, ConvertTo)
+{
+    QuantityArray converted = feet.convertTo(LengthUnits::meter);
+
+    ASSERT_TRUE(converted.getUnit().getSymbol() == "m");
+    ASSERT_DOUBLE_EQ(converted[0], 0.3048);
+    ASSERT_DOUBLE_EQ(converted[2], 0.9144);
+
+    bool exceptionOccured = false;
+    try
+    {
+        meters.convertTo(TimeUnits::second);
+    }
+    catch (IncompatibleUnitsException &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+}
+
+TEST_F(QuantityArrayTest, AddSubtract)
+{
+    QuantityArray sum = meters + feet;
+    ASSERT_TRUE(sum.getUnit().getSymbol() == "m");
+    ASSERT_DOUBLE_EQ(sum[0], 1.3048);
+    ASSERT_DOUBLE_EQ(sum[2], 3.9144);
+
+    QuantityArray difference = meters - Quantity(LengthUnits::kilometer, 0.001);
+    ASSERT_DOUBLE_EQ(difference[0], 0.0);
+    ASSERT_DOUBLE_EQ(difference[2], 2.0);
+
+    ASSERT_DOUBLE_EQ((meters + 1.0)[1], 3.0);
+
+    bool exceptionOccured = false;
+    try
+    {
+        meters.add(seconds);
+    }
+    catch (IncompatibleUnitsException &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+
+    exceptionOccured = false;
+    try
+    {
+        meters.add(QuantityArray(LengthUnits::meter, std::vector<double>(1, 1.0)));
+    }
+    catch (std::length_error &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+}
+
+TEST_F(QuantityArrayTest, MultiplyDivide)
+{
+    QuantityArray speeds = meters / seconds;
+    ASSERT_TRUE(speeds.getUnit().getSymbol() == "m/s");
+    ASSERT_TRUE(speeds.getUnit() == SpeedUnits::meterPerSecond);
+    ASSERT_DOUBLE_EQ(speeds[0], 0.5);
+
+    QuantityArray areas = meters * Quantity(LengthUnits::meter, 2.0);
+    ASSERT_TRUE(areas.getUnit() == AreaUnits::meter2);
+    ASSERT_DOUBLE_EQ(areas[2], 6.0);
+
+    // scalars scale the values only, like multiplyBy(double)
+    QuantityArray halves = meters / 2.0;
+    ASSERT_TRUE(halves.getUnit() == LengthUnits::meter);
+    ASSERT_TRUE(halves.at(1) == Quantity(LengthUnits::meter, 1.0));
+    ASSERT_TRUE((meters * 0.5).at(2) == halves.at(2));
+
+    bool exceptionOccured = false;
+    try
+    {
+        meters.multiplyBy(QuantityArray(TemperatureUnits::degreeCelsius, 3, 1.0));
+    }
+    catch (UnitUnsupportedOperationException &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+}
+
+}
+}
@@ -0,0 +1,167 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/quantityexpression.h>
+#include <quantify/standardunits.h>
+#include <quantify/utils.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+class QuantityExpressionTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        mass = Quantity(MassUnits::kilogram, 2.0);
+        speed = Quantity(SpeedUnits::kilometerPerHour, 36.0);
+        time = Quantity(TimeUnits::second, 4.0);
+        force = Quantity(ForceUnits::newton, 3.0);
+    }
+
+    Quantity mass;
+    Quantity speed;
+    Quantity time;
+    Quantity force;
+};
+
+TEST_F(QuantityExpressionTest, MatchesQuantityArithmetic)
+{
+    Quantity fused = Expressions::of(mass) * speed / time + force;
+    Quantity expected = (mass * speed) / time + force;
+
+    ASSERT_TRUE(fused.getUnit() == expected.getUnit());
+    ASSERT_STREQ(expected.getUnit().getSymbol().c_str(), fused.getUnit().getSymbol().c_str());
+    ASSERT_NEAR(expected.getValue(), fused.getValue(), 1e-12);
+
+    Quantity difference = Expressions::of(Quantity(LengthUnits::meter, 1.0)) - Quantity(LengthUnits::foot, 1.0);
+    ASSERT_NEAR(0.6952, difference.getValue(), 1e-12);
+    ASSERT_TRUE(difference.getUnit() == LengthUnits::meter);
+
+    Quantity celsius = Expressions::of(Quantity(TemperatureUnits::degreeCelsius, 1.0)) + Quantity(TemperatureUnits::kelvin, 1.0);
+    ASSERT_NEAR(-271.15, celsius.getValue(), 1e-9);
+
+    Quantity scaled = 2.0 * (Expressions::of(time) * 3.0) + 1.0 - 0.5;
+    ASSERT_TRUE(Utils::areEqual(24.5, scaled.getValue()));
+    ASSERT_TRUE(scaled.getUnit() == TimeUnits::second);
+
+    Quantity frequency = 1.0 / Expressions::of(time);
+    ASSERT_TRUE(Utils::areEqual(0.25, frequency.getValue()));
+    ASSERT_TRUE(frequency.getUnit() == FrequencyUnits::hertz);
+
+    Quantity remaining = 10.0 - Expressions::of(time) / 3.0;
+    ASSERT_EQ(10.0 - 4.0 / 3.0, remaining.getValue());
+    ASSERT_TRUE(remaining.getUnit() == TimeUnits::second);
+
+    Quantity halved = (Expressions::of(mass) * speed) / 2.0 + mass * speed;
+    ASSERT_TRUE(Utils::areEqual(1.5 * (mass * speed).getValue(), halved.getValue()));
+    ASSERT_TRUE(halved.getUnit() == (mass * speed).getUnit());
+}
+
+TEST_F(QuantityExpressionTest, Arrays)
+{
+    QuantityArray voltages(ElectricUnits::volt, std::vector<double>({1.0, 2.0, 3.0}));
+    QuantityArray currents(ElectricUnits::ampere, std::vector<double>({4.0, 5.0, 6.0}));
+    QuantityArray baseline(EnergyUnits::kilowatt, std::vector<double>({0.001, 0.002, 0.003}));
+
+    QuantityArray power = Expressions::of(voltages) * currents + baseline;
+    QuantityArray expected = (voltages * currents) + baseline;
+
+    ASSERT_EQ(3u, power.size());
+    ASSERT_TRUE(power.getUnit() == EnergyUnits::watt);
+    for(std::size_t i=0; i<power.size(); ++i)
+        ASSERT_NEAR(expected[i], power[i], 1e-12);
+
+    QuantityArray doubled = Expressions::of(voltages) * Quantity(Unit(), 2.0);
+    ASSERT_TRUE(Utils::areEqual(6.0, doubled[2]));
+
+    QuantityArray shifted = Quantity(ElectricUnits::volt, 10.0) + Expressions::of(voltages);
+    ASSERT_TRUE(Utils::areEqual(13.0, shifted[2]));
+}
+
+template<typename E>
+std::vector<QuantityArray> evaluateConcurrently(const E &expression)
+{
+    std::vector<QuantityArray> results(4);
+    std::vector<std::thread> threads;
+    for(std::size_t i=0; i<results.size(); ++i)
+        threads.push_back(std::thread([&expression, &results, i]() { results[i] = expression.evaluate(); }));
+
+    for(std::thread &thread : threads)
+        thread.join();
+
+    return results;
+}
+
+TEST_F(QuantityExpressionTest, SharedAcrossThreads)
+{
+    QuantityArray lengths(LengthUnits::meter, std::vector<double>({1.0, 2.0, 3.0}));
+    QuantityArray feet(LengthUnits::foot, std::vector<double>({10.0, 20.0, 30.0}));
+
+    const std::vector<QuantityArray> results = evaluateConcurrently(Expressions::of(lengths) + feet - lengths);
+    for(const QuantityArray &result : results)
+    {
+        ASSERT_TRUE(result.getUnit() == LengthUnits::meter);
+        ASSERT_NEAR(6.096, result[1], 1e-12);
+    }
+}
+
+TEST_F(QuantityExpressionTest, Errors)
+{
+    bool exceptionOccured = false;
+    try
+    {
+        Quantity invalid = Expressions::of(mass) + time;
+        (void) invalid;
+    }
+    catch (IncompatibleUnitsException &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+
+    exceptionOccured = false;
+    try
+    {
+        QuantityArray invalid = Expressions::of(QuantityArray(LengthUnits::meter, 3)) * QuantityArray(LengthUnits::meter, 2);
+        (void) invalid;
+    }
+    catch (std::length_error &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+}
+
+}
+}
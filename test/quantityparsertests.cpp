@@ -0,0 +1,133 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/quantityparser.h>
+#include <quantify/standardunits.h>
+#include <cstring>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+TEST(QuantityParserTest, Parse)
+{
+    Quantity quantity;
+
+    ASSERT_EQ(QuantityParser::Status::Ok, QuantityParser::parse("12.5 km/h", quantity));
+    ASSERT_EQ(12.5, quantity.getValue());
+    ASSERT_TRUE(quantity.getUnit() == SpeedUnits::kilometerPerHour);
+
+    ASSERT_EQ(QuantityParser::Status::Ok, QuantityParser::parse("  36.9 °C\r", quantity));
+    ASSERT_EQ(36.9, quantity.getValue());
+    ASSERT_TRUE(quantity.getUnit() == TemperatureUnits::degreeCelsius);
+
+    ASSERT_EQ(QuantityParser::Status::Ok, QuantityParser::parse("1.2e3 kWh", quantity));
+    ASSERT_EQ(1200.0, quantity.getValue());
+    ASSERT_TRUE(quantity.getUnit() == EnergyUnits::kilowattHour);
+
+    ASSERT_EQ(QuantityParser::Status::Ok, QuantityParser::parse("-3kg*m/s^2", quantity));
+    ASSERT_EQ(-3.0, quantity.getValue());
+    ASSERT_TRUE(quantity.getUnit() == ForceUnits::newton);
+
+    ASSERT_EQ(QuantityParser::Status::Ok, QuantityParser::parse("0.25", quantity));
+    ASSERT_EQ(0.25, quantity.getValue());
+    ASSERT_TRUE(quantity.getUnit().getDimensions() == Dimensions());
+}
+
+TEST(QuantityParserTest, ZeroCopy)
+{
+    const char *buffer = "7 m, 8 s";
+    Quantity quantity;
+
+    ASSERT_EQ(QuantityParser::Status::Ok, QuantityParser::parse(buffer, 3, quantity));
+    ASSERT_EQ(7.0, quantity.getValue());
+    ASSERT_TRUE(quantity.getUnit() == LengthUnits::meter);
+
+    ASSERT_EQ(QuantityParser::Status::Ok, QuantityParser::parse(buffer + 5, 3, quantity));
+    ASSERT_TRUE(quantity.getUnit() == TimeUnits::second);
+}
+
+TEST(QuantityParserTest, Numbers)
+{
+    const char *inputs[] = {"0", "-0.0", "1e10", "1.7976931348623157e308", "2.2250738585072014e-308", "0.1",
+                            "123456789012345678901234567890", "3.14159265358979323846", "+.5", "5.", "1E-5"};
+
+    for(const char *input : inputs)
+    {
+        const char *cursor = input;
+        double value = 0;
+
+        ASSERT_TRUE(QuantityParser::parseNumber(cursor, input + std::strlen(input), value)) << input;
+        ASSERT_EQ(input + std::strlen(input), cursor) << input;
+        ASSERT_DOUBLE_EQ(std::strtod(input, nullptr), value) << input;
+    }
+
+    const char *text = "2 e";
+    const char *cursor = text;
+    double value = 0;
+    ASSERT_TRUE(QuantityParser::parseNumber(cursor, text + 3, value));
+    ASSERT_EQ(text + 1, cursor);
+}
+
+TEST(QuantityParserTest, Errors)
+{
+    Quantity quantity(LengthUnits::meter, 1.0);
+
+    ASSERT_EQ(QuantityParser::Status::Empty, QuantityParser::parse("  ", quantity));
+    ASSERT_EQ(QuantityParser::Status::InvalidNumber, QuantityParser::parse("abc m", quantity));
+    ASSERT_EQ(QuantityParser::Status::InvalidNumber, QuantityParser::parse("- m", quantity));
+    ASSERT_EQ(QuantityParser::Status::InvalidNumber, QuantityParser::parse("1.2.3 m", quantity));
+    ASSERT_EQ(QuantityParser::Status::InvalidUnit, QuantityParser::parse("1 furlongs", quantity));
+    ASSERT_EQ(QuantityParser::Status::InvalidUnit, QuantityParser::parse("1 furlongs", quantity));
+    ASSERT_EQ(QuantityParser::Status::InvalidUnit, QuantityParser::parse("1 °C*s", quantity));
+
+    ASSERT_EQ(1.0, quantity.getValue());
+    ASSERT_STREQ("invalid unit", QuantityParser::getStatusName(QuantityParser::Status::InvalidUnit));
+}
+
+TEST(QuantityParserTest, ParseLines)
+{
+    const std::string buffer = "1 m\r\n2 ft\n\nbad\n5 qq\n3 s";
+    std::vector<Quantity> quantities;
+    std::vector<QuantityParser::Status> statuses;
+
+    ASSERT_EQ(3u, QuantityParser::parseLines(buffer.data(), buffer.size(), quantities, statuses));
+    ASSERT_EQ(6u, quantities.size());
+    ASSERT_EQ(6u, statuses.size());
+
+    ASSERT_EQ(QuantityParser::Status::Ok, statuses[0]);
+    ASSERT_EQ(QuantityParser::Status::Ok, statuses[1]);
+    ASSERT_EQ(QuantityParser::Status::Empty, statuses[2]);
+    ASSERT_EQ(QuantityParser::Status::InvalidNumber, statuses[3]);
+    ASSERT_EQ(QuantityParser::Status::InvalidUnit, statuses[4]);
+    ASSERT_EQ(QuantityParser::Status::Ok, statuses[5]);
+
+    ASSERT_TRUE(quantities[1].getUnit() == LengthUnits::foot);
+    ASSERT_EQ(3.0, quantities[5].getValue());
+}
+
+}
+}
@@ -28,7 +28,14 @@
 #include <quantify/utils.h>
 #include <quantify/incompatibleunitsexception.h>
 #include <quantify/unitunsupportedoperationexception.h>
+#include <quantify/dimensionsoverflowexception.h>
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace Quantify::StandardUnits;
 
@@ -124,6 +131,27 @@ TEST_F(QuantityTest, GreaterThan)
     ASSERT_TRUE(exceptionOccured);
 }
 
+TEST_F(QuantityTest, Compare)
+{
+    Quantity foot(LengthUnits::foot, 1.0);
+    Quantity meter(LengthUnits::meter, 1.0);
+    Quantity hundredCentimeters(LengthUnits::centimeter, 100.0);
+    Quantity nan(LengthUnits::meter, std::numeric_limits<double>::quiet_NaN());
+
+    ASSERT_EQ(Ordering::Less, foot.compare(meter));
+    ASSERT_EQ(Ordering::Greater, meter.compare(foot));
+    ASSERT_EQ(Ordering::Equal, meter.compare(hundredCentimeters));
+    ASSERT_EQ(Ordering::Unordered, nan.compare(meter));
+    ASSERT_EQ(Ordering::Less, meter.compare(2.0));
+    ASSERT_TRUE(meter <= hundredCentimeters);
+    ASSERT_TRUE(meter >= hundredCentimeters);
+    ASSERT_TRUE(foot <= meter);
+    ASSERT_FALSE(foot >= meter);
+    ASSERT_FALSE(nan <= meter);
+    ASSERT_FALSE(nan >= meter);
+    ASSERT_THROW(meter.compare(oneSecond), IncompatibleUnitsException);
+}
+
 TEST_F(QuantityTest, Add)
 {
     Quantity oneFoot(LengthUnits::foot, 1.0);
@@ -149,6 +177,13 @@ TEST_F(QuantityTest, Add)
     ASSERT_TRUE(exceptionOccured);
 }
 
+TEST_F(QuantityTest, AddOffsetUnits)
+{
+    Quantity sum = oneCelsius.add(oneKelvin);
+    ASSERT_TRUE(Utils::areEqual(sum.getValue(), -271.15));
+    ASSERT_FALSE(oneCelsius == oneKelvin);
+}
+
 TEST_F(QuantityTest, Subtract)
 {
     Quantity oneFoot(LengthUnits::foot, 1.0);
@@ -209,6 +244,122 @@ TEST_F(QuantityTest, Divide)
     ASSERT_TRUE(exceptionOccured);
 }
 
+TEST_F(QuantityTest, TryOperations)
+{
+    Quantity result(LengthUnits::meter, 42.0);
+
+    ASSERT_EQ(OperationStatus::IncompatibleUnits, oneMeter.tryConvertTo(TimeUnits::second, result));
+    ASSERT_EQ(OperationStatus::IncompatibleUnits, oneMeter.tryAdd(oneSecond, result));
+    ASSERT_EQ(OperationStatus::IncompatibleUnits, oneMeter.trySubtract(oneKelvin, result));
+    ASSERT_EQ(OperationStatus::UnsupportedOperation, oneMeter.tryMultiplyBy(oneCelsius, result));
+    ASSERT_EQ(OperationStatus::UnsupportedOperation, oneCelsius.tryDivideBy(oneMeter, result));
+    ASSERT_TRUE(result.getUnit() == LengthUnits::meter);
+    ASSERT_TRUE(result == 42.0);
+
+    ASSERT_EQ(OperationStatus::Ok, oneKelvin.tryConvertTo(TemperatureUnits::degreeCelsius, result));
+    ASSERT_TRUE(Utils::areEqual(result.getValue(), -272.15));
+
+    ASSERT_EQ(OperationStatus::Ok, oneMeter.tryAdd(Quantity(LengthUnits::foot, 1.0), result));
+    ASSERT_TRUE(Utils::areEqual(result.getValue(), 1.3048));
+
+    ASSERT_EQ(OperationStatus::Ok, oneMeter.trySubtract(oneMeter, result));
+    ASSERT_TRUE(result == 0.0);
+
+    ASSERT_EQ(OperationStatus::Ok, (2.0 * oneMeter).tryMultiplyBy(oneMeter, result));
+    ASSERT_TRUE(result == 2.0);
+    ASSERT_TRUE(result.getUnit() == LengthUnits::meter.power(2));
+
+    ASSERT_EQ(OperationStatus::Ok, oneMeter.tryDivideBy(2.0 * oneSecond, result));
+    ASSERT_TRUE(result == 0.5);
+    ASSERT_TRUE(result.getUnit() == StandardUnits::SpeedUnits::meterPerSecond);
+
+    Quantity big(Unit("big", "b", Dimensions(100)), 1.0);
+    ASSERT_EQ(OperationStatus::DimensionsOverflow, big.tryMultiplyBy(big, result));
+
+    Quantity converted = oneMeter;
+    ASSERT_EQ(OperationStatus::Ok, converted.tryConvertTo(LengthUnits::centimeter, converted));
+    ASSERT_TRUE(Utils::areEqual(converted.getValue(), 100.0));
+}
+
+TEST_F(QuantityTest, ExceptionsOwnTheirData)
+{
+    std::string message;
+    try
+    {
+        Quantity(Unit("furlong per fortnight", "fur/ftn", Dimensions(1, 0, -1)), 1.0).add(oneMeter);
+    }
+    catch (IncompatibleUnitsException &ex)
+    {
+        message = ex.what();
+        ASSERT_TRUE(ex.getLeftUnit() == LengthUnits::meter);
+        ASSERT_STREQ("fur/ftn", ex.getRightUnit().getSymbol().c_str());
+    }
+
+    ASSERT_STREQ("Units \"m\" and \"fur/ftn\" are not compatible.", message.c_str());
+
+    bool exceptionOccured = false;
+    try
+    {
+        oneCelsius.multiplyBy(oneMeter);
+    }
+    catch (UnitUnsupportedOperationException &ex)
+    {
+        exceptionOccured = true;
+        ASSERT_TRUE(ex.getUnit() == TemperatureUnits::degreeCelsius);
+        ASSERT_TRUE(std::string(ex.what()).find("Hint") != std::string::npos);
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+
+    exceptionOccured = false;
+    try
+    {
+        Dimensions(0, 0, 2).power(64);
+    }
+    catch (DimensionsOverflowException &ex)
+    {
+        exceptionOccured = true;
+        ASSERT_EQ(64, ex.getPower());
+        ASSERT_STREQ("Dimensions [0, 0, 2, 0, 0, 0, 0] overflow in operation \"^64\".", ex.what());
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+}
+
+TEST_F(QuantityTest, ExceptionMessageAcrossThreads)
+{
+    const std::exception_ptr error = std::make_exception_ptr(IncompatibleUnitsException(LengthUnits::meter, TimeUnits::second));
+
+    std::vector<std::string> messages(4);
+    std::vector<std::thread> readers;
+    for(std::size_t i=0; i<messages.size(); ++i)
+    {
+        readers.push_back(std::thread([&error, &messages, i]()
+        {
+            try
+            {
+                std::rethrow_exception(error);
+            }
+            catch(const IncompatibleUnitsException &ex)
+            {
+                messages[i] = ex.what();
+            }
+        }));
+    }
+
+    for(std::thread &reader : readers)
+        reader.join();
+
+    for(const std::string &message : messages)
+        ASSERT_EQ("Units \"m\" and \"s\" are not compatible.", message);
+
+    // assigned exceptions format their new message
+    IncompatibleUnitsException copy(LengthUnits::meter, LengthUnits::foot);
+    ASSERT_STREQ("Units \"m\" and \"ft\" are not compatible.", copy.what());
+    copy = IncompatibleUnitsException(TimeUnits::second, LengthUnits::meter);
+    ASSERT_STREQ("Units \"s\" and \"m\" are not compatible.", copy.what());
+}
+
 TEST_F(QuantityTest, ToInt)
 {
     Quantity meters = 1.49 * oneMeter;
@@ -223,6 +374,23 @@ TEST_F(QuantityTest, ToInt)
 
     ASSERT_TRUE(result2 == expected2);
 }
+TEST_F(QuantityTest, Layout)
+{
+    static_assert(sizeof(Quantity) == 16, "Quantity must be a double and a unit reference");
+
+    std::vector<Quantity> quantities;
+    for(int i=0; i<8; ++i)
+        quantities.push_back(Quantity(i % 2 ? LengthUnits::kilometer : LengthUnits::meter, 8.0 - i));
+
+    std::vector<Quantity> copies = quantities;
+    std::sort(copies.begin(), copies.end());
+
+    ASSERT_EQ(&LengthUnits::meter.getName(), &quantities[0].getUnit().getName());
+    ASSERT_DOUBLE_EQ(2.0, copies.front().getValue());
+    ASSERT_TRUE(copies.front().getUnit() == LengthUnits::meter);
+    ASSERT_DOUBLE_EQ(7.0, copies.back().getValue());
+    ASSERT_TRUE(copies.back().getUnit() == LengthUnits::kilometer);
+}
 
 }
 }
@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/rational.h>
+#include <sstream>
+
+namespace Quantify {
+namespace Test {
+
+TEST(RationalTest, Reduced)
+{
+    constexpr Rational kilometerPerHour(1000, 3600);
+    static_assert(kilometerPerHour == Rational(5, 18), "Rationals must be reduced at compile time");
+    static_assert(Rational(3048, 1, -4) == Rational(381, 1250), "Rationals must be reduced at compile time");
+    static_assert(Rational(1, 8) == Rational(125, 1, -3), "Decimal denominators must be folded into the exponent");
+    static_assert(Rational(1000).getNumerator() == 1 && Rational(1000).getExponent() == 3, "Trailing zeros must move to the exponent");
+
+    ASSERT_EQ(Rational(-1, 2), Rational(2, -4));
+    ASSERT_EQ(1, Rational(0, 7, 5).getDenominator());
+    ASSERT_EQ(0, Rational(0, 7, 5).getExponent());
+    ASSERT_FALSE(Rational().isValid());
+    ASSERT_FALSE(Rational(1, 0).isValid());
+    ASSERT_EQ(Rational(), Rational(5, 0, 3));
+}
+
+TEST(RationalTest, FromDouble)
+{
+    ASSERT_EQ(Rational(254, 1, -4), Rational::fromDouble(0.0254));
+    ASSERT_EQ(Rational(1, 1, -3), Rational::fromDouble(0.001));
+    ASSERT_EQ(Rational(44482216152605, 1, -13), Rational::fromDouble(4.4482216152605));
+    ASSERT_EQ(Rational(9460730472580800), Rational::fromDouble(9460730472580800.0));
+    ASSERT_EQ(Rational(-5, 1, -1), Rational::fromDouble(-0.5));
+    ASSERT_EQ(Rational(0), Rational::fromDouble(0.0));
+    ASSERT_FALSE(Rational::fromDouble(1.0 / 3.0).isValid());
+    ASSERT_FALSE(Rational::fromDouble(1e300).isValid());
+}
+
+TEST(RationalTest, Arithmetic)
+{
+    const Rational inch(254, 1, -4);
+
+    ASSERT_EQ(Rational(3048, 1, -4), Rational(12) * inch);
+    ASSERT_EQ(Rational(12), Rational(3048, 1, -4) / inch);
+    ASSERT_EQ(Rational(64516, 1, -8), inch.power(2));
+    ASSERT_EQ(Rational(1), inch.power(0));
+    ASSERT_EQ(Rational(10000, 254), inch.power(-1));
+    ASSERT_EQ(Rational(5, 18), Rational(1000) / Rational(3600));
+    ASSERT_DOUBLE_EQ(5.0 / 18.0, Rational(5, 18).toDouble());
+
+    ASSERT_FALSE((Rational(1) / Rational(0)).isValid());
+    ASSERT_FALSE((Rational(1) * Rational()).isValid());
+    ASSERT_FALSE((Rational(3, 1) * Rational(3037000499) * Rational(3037000499) * Rational(3)).isValid());
+    ASSERT_FALSE(Rational(1, 1, 200).power(2).isValid());
+
+    std::stringstream stream;
+    stream << Rational(5, 9, -3) << " " << Rational(3) << " " << Rational();
+    ASSERT_EQ("5/9e-3 3 inexact", stream.str());
+}
+
+}
+}
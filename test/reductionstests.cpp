@@ -0,0 +1,167 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <quantify/reductions.h>
+#include <quantify/standardunits.h>
+#include <quantify/unitunsupportedoperationexception.h>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+static std::vector<Quantity> makeLengths(std::size_t count)
+{
+    const Unit units[] = {LengthUnits::meter, LengthUnits::kilometer, LengthUnits::foot, LengthUnits::centimeter};
+
+    std::vector<Quantity> quantities;
+    for(std::size_t i=0; i<count; ++i)
+        quantities.push_back(Quantity(units[i % 4], 0.1 * (double) (i % 977) - 20.0));
+
+    return quantities;
+}
+
+TEST(ReductionsTest, Summary)
+{
+    const std::vector<Quantity> quantities = {Quantity(LengthUnits::meter, 2.0), Quantity(LengthUnits::centimeter, 400.0), Quantity(LengthUnits::kilometer, 0.006)};
+    const Reductions::Summary summary = Reductions::summarize(quantities, LengthUnits::meter);
+
+    ASSERT_EQ(3u, summary.getCount());
+    ASSERT_TRUE(summary.getUnit() == LengthUnits::meter);
+    ASSERT_DOUBLE_EQ(12.0, summary.getSum().getValue());
+    ASSERT_DOUBLE_EQ(4.0, summary.getMean().getValue());
+    ASSERT_DOUBLE_EQ(2.0, summary.getMin().getValue());
+    ASSERT_DOUBLE_EQ(6.0, summary.getMax().getValue());
+    ASSERT_DOUBLE_EQ(8.0 / 3.0, summary.getVariance().getValue());
+    ASSERT_TRUE(summary.getVariance().getUnit() == LengthUnits::meter.power(2));
+    ASSERT_DOUBLE_EQ(std::sqrt(8.0 / 3.0), summary.getStandardDeviation().getValue());
+
+    const Quantity sum = Reductions::sum(quantities, LengthUnits::centimeter);
+    ASSERT_TRUE(sum.getUnit() == LengthUnits::centimeter);
+    ASSERT_DOUBLE_EQ(1200.0, sum.getValue());
+}
+
+TEST(ReductionsTest, Empty)
+{
+    const Reductions::Summary summary = Reductions::summarize(std::vector<Quantity>(), LengthUnits::meter);
+
+    ASSERT_EQ(0u, summary.getCount());
+    ASSERT_EQ(0.0, summary.getSum().getValue());
+    ASSERT_TRUE(std::isnan(summary.getMean().getValue()));
+    ASSERT_TRUE(std::isnan(summary.getMin().getValue()));
+    ASSERT_TRUE(std::isnan(summary.getMax().getValue()));
+    ASSERT_TRUE(std::isnan(summary.getVariance().getValue()));
+}
+
+TEST(ReductionsTest, DeterministicAcrossThreads)
+{
+    const std::vector<Quantity> quantities = makeLengths(10 * QUANTIFY_REDUCTIONS_BLOCK_SIZE + 123);
+    const Reductions::Summary reference = Reductions::summarize(quantities, LengthUnits::meter, 1);
+
+    for(unsigned int threads : {2u, 3u, 8u, 64u, 0u})
+    {
+        const Reductions::Summary summary = Reductions::summarize(quantities, LengthUnits::meter, threads);
+
+        ASSERT_EQ(reference.getCount(), summary.getCount());
+        ASSERT_EQ(reference.getSum().getValue(), summary.getSum().getValue());
+        ASSERT_EQ(reference.getMin().getValue(), summary.getMin().getValue());
+        ASSERT_EQ(reference.getMax().getValue(), summary.getMax().getValue());
+        ASSERT_EQ(reference.getVariance().getValue(), summary.getVariance().getValue());
+    }
+
+    double sum = 0.0;
+    for(const Quantity &quantity : quantities)
+        sum += quantity.convertTo(LengthUnits::meter).getValue();
+    ASSERT_NEAR(sum, reference.getSum().getValue(), 1e-9 * std::fabs(sum));
+}
+
+TEST(ReductionsTest, ConcurrentCallers)
+{
+    const std::vector<Quantity> quantities = makeLengths(6 * QUANTIFY_REDUCTIONS_BLOCK_SIZE + 5);
+    const double reference = Reductions::sum(quantities, LengthUnits::meter, 1).getValue();
+
+    // callers share the worker pool, each one repeatedly
+    std::vector<double> sums(4 * 50);
+    std::vector<std::thread> callers;
+    for(std::size_t caller=0; caller<4; ++caller)
+    {
+        callers.push_back(std::thread([&quantities, &sums, caller]()
+        {
+            for(std::size_t i=0; i<50; ++i)
+                sums[caller * 50 + i] = Reductions::sum(quantities, LengthUnits::meter, 4).getValue();
+        }));
+    }
+
+    for(std::thread &caller : callers)
+        caller.join();
+
+    for(double sum : sums)
+        ASSERT_EQ(reference, sum);
+}
+
+TEST(ReductionsTest, QuantityArray)
+{
+    QuantityArray array(TemperatureUnits::degreeCelsius, std::vector<double>(3 * QUANTIFY_REDUCTIONS_BLOCK_SIZE + 7, 25.0));
+    array[0] = -5.0;
+    array[array.size() - 1] = 105.0;
+
+    const Reductions::Summary summary = Reductions::summarize(array, TemperatureUnits::kelvin, 4);
+    ASSERT_EQ(array.size(), summary.getCount());
+    ASSERT_DOUBLE_EQ(268.15, summary.getMin().getValue());
+    ASSERT_DOUBLE_EQ(378.15, summary.getMax().getValue());
+    ASSERT_DOUBLE_EQ(298.15 * (double) array.size() + 50.0, summary.getSum().getValue());
+    ASSERT_TRUE(summary.getMean().getUnit() == TemperatureUnits::kelvin);
+
+    ASSERT_DOUBLE_EQ(-5.0, Reductions::min(array, TemperatureUnits::degreeCelsius).getValue());
+    ASSERT_THROW(Reductions::variance(array, TemperatureUnits::degreeCelsius), UnitUnsupportedOperationException);
+}
+
+TEST(ReductionsTest, CompensatedSum)
+{
+    // naive summation loses every 1.0 against 1e16
+    std::vector<Quantity> quantities(1, Quantity(LengthUnits::meter, 1e16));
+    for(int i=0; i<10000; ++i)
+        quantities.push_back(Quantity(LengthUnits::meter, 1.0));
+    quantities.push_back(Quantity(LengthUnits::meter, -1e16));
+
+    ASSERT_EQ(10000.0, Reductions::sum(quantities, LengthUnits::meter, 1).getValue());
+    ASSERT_EQ(1.0, Reductions::mean(std::vector<Quantity>(QUANTIFY_REDUCTIONS_BLOCK_SIZE + 1, Quantity(LengthUnits::meter, 1.0)), LengthUnits::meter).getValue());
+}
+
+TEST(ReductionsTest, IncompatibleUnits)
+{
+    std::vector<Quantity> quantities = makeLengths(4 * QUANTIFY_REDUCTIONS_BLOCK_SIZE);
+    quantities[3 * QUANTIFY_REDUCTIONS_BLOCK_SIZE + 1] = Quantity(TimeUnits::second, 1.0);
+
+    ASSERT_THROW(Reductions::summarize(quantities, LengthUnits::meter, 4), IncompatibleUnitsException);
+    ASSERT_THROW(Reductions::sum(QuantityArray(TimeUnits::second, std::vector<double>(1, 1.0)), LengthUnits::meter), IncompatibleUnitsException);
+}
+
+}
+}
@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/standardunits.h>
+#include <quantify/utils.h>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+TEST(StandardUnitsTest, MatchCompositions)
+{
+    ASSERT_TRUE(LengthUnits::inch == 1000.0 * LengthUnits::thou);
+    ASSERT_TRUE(LengthUnits::mile == 8.0 * LengthUnits::furlong);
+    ASSERT_TRUE(AreaUnits::meter2 == LengthUnits::meter.power(2));
+    ASSERT_TRUE(AreaUnits::kilometer2 == LengthUnits::kilometer.power(2));
+    ASSERT_TRUE(AreaUnits::inch2 == LengthUnits::inch.power(2));
+    ASSERT_TRUE(VolumeUnits::liter == LengthUnits::decimeter.power(3));
+    ASSERT_TRUE(SpeedUnits::kilometerPerHour == LengthUnits::kilometer / TimeUnits::hour);
+    ASSERT_TRUE(SpeedUnits::milePerHour == LengthUnits::mile / TimeUnits::hour);
+    ASSERT_TRUE(ForceUnits::newton == LengthUnits::meter * MassUnits::kilogram * TimeUnits::second.power(-2));
+    ASSERT_TRUE(EnergyUnits::watt == EnergyUnits::joule / TimeUnits::second);
+    ASSERT_TRUE(EnergyUnits::wattHour == EnergyUnits::watt * TimeUnits::hour);
+    ASSERT_TRUE(EnergyUnits::horsePower == 0.73549875 * EnergyUnits::kilowatt);
+    ASSERT_TRUE(PressureUnits::pascal == ForceUnits::newton / AreaUnits::meter2);
+    ASSERT_TRUE(PressureUnits::poundPerSquareInch == ForceUnits::poundForce / AreaUnits::inch2);
+    ASSERT_TRUE(FrequencyUnits::rpm == TimeUnits::minute.power(-1));
+    ASSERT_TRUE(TorqueUnits::poundFoot == ForceUnits::poundForce * LengthUnits::foot);
+    ASSERT_TRUE(TemperatureUnits::degreeFahrenheit == ((5.0 / 9.0) * TemperatureUnits::kelvin) + ((5.0 / 9.0) * 459.67));
+}
+
+TEST(StandardUnitsTest, ElectricUnitsDoNotDependOnDefinitionOrder)
+{
+    ASSERT_TRUE(ElectricUnits::coulomb == TimeUnits::second * ElectricUnits::ampere);
+    ASSERT_TRUE(ElectricUnits::volt == EnergyUnits::watt / ElectricUnits::ampere);
+    ASSERT_TRUE(ElectricUnits::ohm == ElectricUnits::volt / ElectricUnits::ampere);
+    ASSERT_TRUE(ElectricUnits::farad == ElectricUnits::coulomb / ElectricUnits::volt);
+    ASSERT_TRUE(Utils::areEqual(ElectricUnits::volt.getFactor(), 1.0));
+}
+
+TEST(StandardUnitsTest, Labels)
+{
+    ASSERT_STREQ("kilometer/hour", SpeedUnits::kilometerPerHour.getName().c_str());
+    ASSERT_STREQ("°C", TemperatureUnits::degreeCelsius.getSymbol().c_str());
+    ASSERT_STREQ("kg*m", (MassUnits::kilogram * LengthUnits::meter).getSymbol().c_str());
+}
+
+TEST(StandardUnitsTest, AllUnits)
+{
+    const Unit *const *units = AllUnits::getUnits();
+
+    ASSERT_EQ(79u, AllUnits::getCount());
+    ASSERT_EQ(&LengthUnits::meter, units[0]);
+    ASSERT_EQ(&TorqueUnits::poundFoot, units[AllUnits::getCount() - 1]);
+}
+
+}
+}
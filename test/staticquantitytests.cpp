@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/staticquantity.h>
+#include <quantify/standardunits.h>
+#include <quantify/incompatibleunitsexception.h>
+#include <type_traits>
+
+using namespace Quantify::StandardUnits;
+using namespace Quantify::StaticQuantities;
+
+namespace Quantify {
+namespace Test {
+
+TEST(StaticQuantityTest, ZeroOverhead)
+{
+    static_assert(sizeof(Meters) == sizeof(double), "StaticQuantity must only store a double");
+    static_assert(std::is_trivially_copyable<KilometersPerHour>::value, "StaticQuantity must be trivially copyable");
+
+    constexpr Meters distance(100.0);
+    constexpr Seconds time(20.0);
+    constexpr MetersPerSecond speed = distance / time;
+    static_assert(speed.getValue() == 5.0, "StaticQuantity arithmetic must be usable in constant expressions");
+}
+
+TEST(StaticQuantityTest, Arithmetic)
+{
+    Kilometers kilometers(1.5);
+    Meters meters(500.0);
+
+    Kilometers sum = kilometers + meters;
+    ASSERT_DOUBLE_EQ(sum.getValue(), 2.0);
+    ASSERT_DOUBLE_EQ((meters - kilometers).getValue(), -1000.0);
+    ASSERT_DOUBLE_EQ(sum.convertTo<std::ratio<1>>().getValue(), 2000.0);
+
+    KilometersPerHour speed = kilometers / Hours(0.5);
+    ASSERT_DOUBLE_EQ(speed.getValue(), 3.0);
+    ASSERT_NEAR(MetersPerSecond(speed).getValue(), 0.833333333333, 1e-9);
+
+    Newtons force = Kilograms(2.0) * (Meters(3.0) / (Seconds(1.0) * Seconds(2.0)));
+    ASSERT_DOUBLE_EQ(force.getValue(), 3.0);
+
+    Joules work = force * Meters(2.0);
+    ASSERT_DOUBLE_EQ((work / Seconds(3.0)).getValue(), 2.0);
+    ASSERT_TRUE((std::is_same<decltype(work / Seconds(3.0)), Watts>::value));
+
+    ASSERT_TRUE(Meters(1000.0) == Kilometers(1.0));
+    ASSERT_TRUE(Meters(999.0) < Kilometers(1.0));
+    ASSERT_TRUE(Meters(1000.0) >= Kilometers(1.0));
+    ASSERT_DOUBLE_EQ((1.0 / Seconds(0.5)).getValue(), 2.0);
+    ASSERT_DOUBLE_EQ((2.0 * meters).getValue(), 1000.0);
+}
+
+TEST(StaticQuantityTest, ToQuantity)
+{
+    Quantity speed = static_cast<Quantity>(KilometersPerHour(36.0));
+    ASSERT_TRUE(speed.getUnit() == SpeedUnits::kilometerPerHour);
+    ASSERT_NEAR(speed.convertTo(SpeedUnits::meterPerSecond).getValue(), 10.0, 1e-12);
+
+    Quantity force = Newtons(1.0).toQuantity(ForceUnits::newton);
+    ASSERT_DOUBLE_EQ(force.getValue(), 1.0);
+    ASSERT_STREQ("m*kg*s^-2", Newtons::getUnit().getSymbol().c_str());
+    ASSERT_STREQ("1000*m", Kilometers::getUnit().getSymbol().c_str());
+}
+
+TEST(StaticQuantityTest, FromQuantity)
+{
+    Meters meters(Quantity(LengthUnits::foot, 1.0));
+    ASSERT_DOUBLE_EQ(meters.getValue(), 0.3048);
+
+    Kelvins kelvins(Quantity(TemperatureUnits::degreeCelsius, 0.0));
+    ASSERT_DOUBLE_EQ(kelvins.getValue(), 273.15);
+
+    bool exceptionOccured = false;
+    try
+    {
+        Seconds seconds((Quantity(LengthUnits::meter, 1.0)));
+    }
+    catch (IncompatibleUnitsException &ex)
+    {
+        exceptionOccured = true;
+    }
+
+    ASSERT_TRUE(exceptionOccured);
+}
+
+}
+}
@@ -0,0 +1,175 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/standardunits.h>
+#include <quantify/unitparser.h>
+#include <quantify/unitparseexception.h>
+#include <quantify/utils.h>
+#include <locale>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+TEST(UnitParserTest, Symbols)
+{
+    ASSERT_TRUE(UnitParser::parse("m") == LengthUnits::meter);
+    ASSERT_TRUE(UnitParser::parse("°C") == TemperatureUnits::degreeCelsius);
+    ASSERT_TRUE(UnitParser::parse("kWh") == EnergyUnits::kilowattHour);
+    ASSERT_TRUE(UnitParser::parse("kilometer") == LengthUnits::kilometer);
+    ASSERT_TRUE(UnitParser::parse("degree Fahrenheit") == TemperatureUnits::degreeFahrenheit);
+
+    Unit speed = UnitParser::parse("km/h");
+    ASSERT_TRUE(speed == SpeedUnits::kilometerPerHour);
+    ASSERT_STREQ("kilometer/hour", speed.getName().c_str());
+}
+
+TEST(UnitParserTest, Expressions)
+{
+    Unit newton = UnitParser::parse("kg*m/s^2");
+    ASSERT_TRUE(newton == ForceUnits::newton);
+    ASSERT_STREQ("kg*m/s^2", newton.getSymbol().c_str());
+
+    ASSERT_TRUE(UnitParser::parse("N m") == EnergyUnits::joule);
+    ASSERT_TRUE(UnitParser::parse("N·m") == EnergyUnits::joule);
+    ASSERT_TRUE(UnitParser::parse(" ( kg * m ) / ( s * s ) ") == ForceUnits::newton);
+    ASSERT_TRUE(UnitParser::parse("m s-1") == SpeedUnits::meterPerSecond);
+    ASSERT_TRUE(UnitParser::parse("m2") == AreaUnits::meter2);
+    ASSERT_TRUE(UnitParser::parse("(km/h)^-1") == TimeUnits::hour / LengthUnits::kilometer);
+    ASSERT_TRUE(UnitParser::parse("1/s") == FrequencyUnits::hertz);
+    ASSERT_TRUE(UnitParser::parse("1000*m") == LengthUnits::kilometer);
+    ASSERT_TRUE(UnitParser::parse("0.5 kg") == MassUnits::pound);
+}
+
+TEST(UnitParserTest, Prefixes)
+{
+    Unit milliwatt = UnitParser::parse("mW");
+    ASSERT_TRUE(Utils::areClose(milliwatt.getFactor(), 0.001, 1e-12));
+    ASSERT_STREQ("milliwatt", milliwatt.getName().c_str());
+    ASSERT_TRUE(milliwatt.isCompatibleTo(EnergyUnits::watt));
+
+    ASSERT_TRUE(UnitParser::parse("GJ") == EnergyUnits::gigajoule);
+    ASSERT_TRUE(UnitParser::parse("μs") == TimeUnits::microsecond);
+    ASSERT_TRUE(UnitParser::parse("us") == TimeUnits::microsecond);
+    ASSERT_TRUE(UnitParser::parse("kilonewton") == 1000.0 * ForceUnits::newton);
+    ASSERT_TRUE(UnitParser::parse("min") == TimeUnits::minute);
+
+    // prefixes keep the exact factor of the base unit
+    ASSERT_EQ(Rational(1, 1, -3), milliwatt.getExactFactor());
+    ASSERT_EQ(Rational(3048, 1, -1), UnitParser::parse("kft").getExactFactor());
+    ASSERT_EQ(Rational(3048, 1, -10), UnitParser::parse("μft").getExactFactor());
+}
+
+TEST(UnitParserTest, AddUnit)
+{
+    Unit counts("count", "cnt", Dimensions(), 1.0);
+    UnitParser::addUnit(counts);
+
+    ASSERT_TRUE(UnitParser::parse("cnt/s") == counts / TimeUnits::second);
+    ASSERT_TRUE(UnitParser::parse("kcnt").getFactor() == 1000.0);
+}
+
+TEST(UnitParserTest, Cache)
+{
+    UnitParser::clearCache();
+    UnitParser::parse("kg*m^2/s^3");
+    UnitParser::Statistics before = UnitParser::getStatistics();
+
+    Unit watt = UnitParser::parse("kg*m^2/s^3");
+    UnitParser::Statistics after = UnitParser::getStatistics();
+
+    ASSERT_TRUE(watt == EnergyUnits::watt);
+    ASSERT_EQ(before.hits + 1, after.hits);
+    ASSERT_EQ(before.misses, after.misses);
+    ASSERT_EQ(1u, after.size);
+}
+
+TEST(UnitParserTest, Errors)
+{
+    const char *invalid[] = {"", "   ", "foo", "m^", "m^x", "(m/s", "m/s)", "m**", "kg*", "^2"};
+
+    for(const char *expression : invalid)
+    {
+        bool exceptionOccured = false;
+        try
+        {
+            UnitParser::parse(expression);
+        }
+        catch (UnitParseException &ex)
+        {
+            exceptionOccured = true;
+            ASSERT_STREQ(expression, ex.getExpression().c_str());
+        }
+
+        ASSERT_TRUE(exceptionOccured) << expression;
+    }
+
+    struct Position
+    {
+        const char *expression;
+        std::size_t position;
+    };
+
+    // errors are reported as UnitParseException at the offending token
+    const Position positions[] = {{"kg*bogus", 3}, {"m99999999999", 1}, {"m200", 1}, {"m^200", 2}, {"s^-99999", 2}, {"m^100*m^100", 6}};
+
+    for(const Position &expected : positions)
+    {
+        bool exceptionOccured = false;
+        try
+        {
+            UnitParser::parse(expected.expression);
+        }
+        catch (UnitParseException &ex)
+        {
+            exceptionOccured = true;
+            ASSERT_EQ(expected.position, ex.getPosition()) << expected.expression;
+        }
+
+        ASSERT_TRUE(exceptionOccured) << expected.expression;
+    }
+}
+
+TEST(UnitParserTest, Numbers)
+{
+    ASSERT_EQ(0.3, UnitParser::parse("0.3").getFactor());
+    ASSERT_EQ(1.2345678901234567, UnitParser::parse("1.2345678901234567").getFactor());
+    ASSERT_EQ(123456789012345678901234567890.0, UnitParser::parse("123456789012345678901234567890").getFactor());
+    ASSERT_EQ(0.5, UnitParser::parse(".5").getFactor());
+
+    // the decimal point does not follow the global locale
+    struct CommaDecimal : std::numpunct<char>
+    {
+        char do_decimal_point() const { return ','; }
+    };
+    const std::locale previous = std::locale::global(std::locale(std::locale::classic(), new CommaDecimal()));
+    const double factor = UnitParser::parse("2.25 m").getFactor();
+    std::locale::global(previous);
+    ASSERT_EQ(2.25, factor);
+}
+
+}
+}
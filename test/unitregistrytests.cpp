@@ -0,0 +1,267 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2017 Damiano Renfer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <quantify/standardunits.h>
+#include <quantify/unitparser.h>
+#include <quantify/unitregistry.h>
+#include <atomic>
+#include <thread>
+
+using namespace Quantify::StandardUnits;
+
+namespace Quantify {
+namespace Test {
+
+class UnitRegistryTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        registry.addStandardUnits();
+    }
+
+    UnitRegistry registry;
+};
+
+TEST_F(UnitRegistryTest, FindBySymbolAndName)
+{
+    ASSERT_EQ(AllUnits::getCount(), registry.size());
+
+    Unit unit;
+    ASSERT_TRUE(registry.findBySymbol("ft", unit));
+    ASSERT_TRUE(unit == LengthUnits::foot);
+
+    ASSERT_TRUE(registry.findByName("degree Celsius", unit));
+    ASSERT_TRUE(unit == TemperatureUnits::degreeCelsius);
+
+    const char *buffer = "km/h, mi/h";
+    ASSERT_TRUE(registry.findBySymbol(buffer, 4, unit));
+    ASSERT_TRUE(unit == SpeedUnits::kilometerPerHour);
+    ASSERT_TRUE(registry.findBySymbol(buffer + 6, 4, unit));
+    ASSERT_TRUE(unit == SpeedUnits::milePerHour);
+
+    ASSERT_FALSE(registry.findBySymbol("foot", unit));
+    ASSERT_FALSE(registry.findByName("ft", unit));
+    ASSERT_FALSE(registry.findBySymbol("", unit));
+    ASSERT_FALSE(UnitRegistry().findBySymbol("m", unit));
+    ASSERT_TRUE(unit == SpeedUnits::milePerHour);
+}
+
+TEST_F(UnitRegistryTest, FindByDimensions)
+{
+    UnitRegistry::Range lengths = registry.findByDimensions(LengthUnits::meter.getDimensions());
+    ASSERT_EQ(16u, lengths.size());
+    ASSERT_TRUE(lengths[0] == LengthUnits::meter);
+    ASSERT_TRUE(lengths[lengths.size() - 1] == LengthUnits::lightYear);
+
+    for(const Unit &unit : lengths)
+        ASSERT_TRUE(unit.isCompatibleTo(LengthUnits::meter));
+
+    UnitRegistry::Range temperatures = registry.findByDimensions(Dimensions(0, 0, 0, 0, 1));
+    ASSERT_EQ(3u, temperatures.size());
+
+    ASSERT_TRUE(registry.findByDimensions(Dimensions(9)).empty());
+
+    std::size_t total = 0;
+    UnitRegistry::Range all = registry.getUnits();
+    for(const Unit *unit = all.begin(); unit != all.end(); unit += registry.findByDimensions(unit->getDimensions()).size())
+        total += registry.findByDimensions(unit->getDimensions()).size();
+
+    ASSERT_EQ(registry.size(), total);
+}
+
+TEST_F(UnitRegistryTest, Add)
+{
+    Unit cubit("cubit", "cbt", Dimensions(1), 0.4572);
+    registry.add(cubit);
+
+    Unit unit;
+    ASSERT_TRUE(registry.findBySymbol("cbt", unit));
+    ASSERT_TRUE(unit == cubit);
+    ASSERT_TRUE(registry.findByName("cubit", unit));
+    ASSERT_TRUE(unit == cubit);
+    ASSERT_EQ(17u, registry.findByDimensions(Dimensions(1)).size());
+
+    Unit ton("metric ton", "ton", Dimensions(0, 1), 1000.0);
+    const std::size_t size = registry.size();
+    registry.add(ton);
+
+    ASSERT_EQ(size, registry.size());
+    ASSERT_TRUE(registry.findBySymbol("ton", unit));
+    ASSERT_STREQ("metric ton", unit.getName().c_str());
+    ASSERT_FALSE(registry.findByName("ton", unit));
+}
+
+TEST_F(UnitRegistryTest, Grow)
+{
+    std::vector<Unit> units;
+    for(int i=0; i<1000; ++i)
+    {
+        const std::string text = std::to_string(i);
+        units.push_back(Unit("unit" + text, "u" + text, Dimensions(0, 0, 0, i % 5), 1.0 + i));
+    }
+
+    registry.add(units);
+
+    ASSERT_EQ(AllUnits::getCount() + 1000, registry.size());
+    for(int i=0; i<1000; ++i)
+    {
+        Unit unit;
+        ASSERT_TRUE(registry.findBySymbol("u" + std::to_string(i), unit));
+        ASSERT_TRUE(unit.getFactor() == 1.0 + i);
+    }
+
+    ASSERT_EQ(200u, registry.findByDimensions(Dimensions(0, 0, 0, 3)).size());
+}
+
+TEST_F(UnitRegistryTest, AddOneByOne)
+{
+    // units added one at a time, every symbol registered three times so the
+    // indexes go through many replacements, deletions and compactions
+    for(int round=0; round<3; ++round)
+    {
+        for(int i=0; i<300; ++i)
+        {
+            const std::string text = std::to_string(i);
+            registry.add(Unit("single" + text, "s" + text, Dimensions(0, 0, 0, 0, 0, i % 7 + 2), round * 1000.0 + i));
+        }
+    }
+
+    ASSERT_EQ(AllUnits::getCount() + 300, registry.size());
+    for(int i=0; i<300; ++i)
+    {
+        const std::string text = std::to_string(i);
+        Unit unit;
+        ASSERT_TRUE(registry.findBySymbol("s" + text, unit));
+        ASSERT_TRUE(unit.getFactor() == 2000.0 + i);
+        ASSERT_TRUE(registry.findByName("single" + text, unit));
+        ASSERT_TRUE(unit.getFactor() == 2000.0 + i);
+    }
+
+    std::size_t total = 0;
+    for(int group=2; group<=8; ++group)
+    {
+        UnitRegistry::Range range = registry.findByDimensions(Dimensions(0, 0, 0, 0, 0, group));
+        for(const Unit &unit : range)
+            ASSERT_TRUE(unit.getDimensions() == Dimensions(0, 0, 0, 0, 0, group));
+        total += range.size();
+    }
+
+    Unit meter;
+    ASSERT_EQ(300u, total);
+    ASSERT_TRUE(registry.findBySymbol("m", meter));
+    ASSERT_EQ(16u, registry.findByDimensions(Dimensions(1)).size());
+}
+
+TEST_F(UnitRegistryTest, ConcurrentReaders)
+{
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> readers;
+
+    for(int i=0; i<4; ++i)
+    {
+        readers.emplace_back([&]()
+        {
+            while(!done.load())
+            {
+                Unit meter;
+                UnitRegistry::Range lengths = registry.findByDimensions(Dimensions(1));
+                if(!registry.findBySymbol("m", meter) || !(meter == LengthUnits::meter) || lengths.size() < 16)
+                    ++failures;
+
+                for(const Unit &unit : lengths)
+                {
+                    if(!unit.isCompatibleTo(LengthUnits::meter))
+                        ++failures;
+                }
+            }
+        });
+    }
+
+    const UnitRegistry::Range previous = registry.findByDimensions(Dimensions(1));
+    for(int i=0; i<200; ++i)
+        registry.add(Unit("calibrated " + std::to_string(i), "cal" + std::to_string(i), Dimensions(1), 1.0 + i * 0.001));
+
+    done = true;
+    for(std::thread &reader : readers)
+        reader.join();
+
+    ASSERT_EQ(0, failures.load());
+    ASSERT_EQ(AllUnits::getCount() + 200, registry.size());
+    ASSERT_EQ(216u, registry.findByDimensions(Dimensions(1)).size());
+    ASSERT_EQ(201u, registry.getGeneration());
+    // ranges keep their snapshot alive
+    ASSERT_EQ(16u, previous.size());
+    ASSERT_TRUE(previous[0] == LengthUnits::meter);
+}
+
+TEST_F(UnitRegistryTest, ReplacedSnapshotsAreReleased)
+{
+    const std::size_t snapshots = UnitRegistry::getSnapshotCount();
+
+    for(int i=0; i<1000; ++i)
+        registry.add(Unit("released " + std::to_string(i), "rel" + std::to_string(i), Dimensions(0, 0, 0, 2), 1.0 + i));
+
+    ASSERT_EQ(snapshots, UnitRegistry::getSnapshotCount());
+    ASSERT_EQ(1000u, registry.findByDimensions(Dimensions(0, 0, 0, 2)).size());
+
+    {
+        const UnitRegistry::Range pinned = registry.getUnits();
+        registry.add(Unit("pinned", "pin", Dimensions(0, 0, 0, 2), 0.5));
+        registry.add(Unit("pinned again", "pin2", Dimensions(0, 0, 0, 2), 0.25));
+
+        ASSERT_EQ(snapshots + 1, UnitRegistry::getSnapshotCount());
+        ASSERT_EQ(AllUnits::getCount() + 1000, pinned.size());
+    }
+
+    ASSERT_EQ(snapshots, UnitRegistry::getSnapshotCount());
+
+    {
+        UnitRegistry temporary;
+        ASSERT_EQ(snapshots + 1, UnitRegistry::getSnapshotCount());
+    }
+
+    ASSERT_EQ(snapshots, UnitRegistry::getSnapshotCount());
+}
+
+TEST(UnitRegistryDefaultTest, SharedWithParser)
+{
+    Unit sensorUnit("sensor tick", "stk", Dimensions(), 0.25);
+    const std::uint32_t generation = UnitRegistry::getDefault().getGeneration();
+
+    Unit unit;
+    ASSERT_TRUE(UnitRegistry::getDefault().findBySymbol("kWh", unit));
+
+    UnitParser::addUnit(sensorUnit);
+
+    ASSERT_EQ(generation + 1, UnitParser::getGeneration());
+    ASSERT_TRUE(UnitRegistry::getDefault().findBySymbol("stk", unit));
+    ASSERT_TRUE(unit == sensorUnit);
+    ASSERT_TRUE(UnitParser::parse("stk/s") == sensorUnit / TimeUnits::second);
+}
+
+}
+}
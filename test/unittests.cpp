@@ -25,6 +25,8 @@
 #include <gtest/gtest.h>
 #include <quantify/unit.h>
 #include <quantify/unitunsupportedoperationexception.h>
+#include <sstream>
+#include <vector>
 
 namespace Quantify {
 namespace Test {
@@ -143,6 +145,29 @@ TEST_F(UnitTest, Divide)
     ASSERT_TRUE(exceptionOccurred);
 }
 
+TEST_F(UnitTest, ComposedNameAndSymbol)
+{
+    Unit newton = (kilogram * meter) / second.power(2);
+
+    ASSERT_STREQ("kg*m/s^2", newton.getSymbol().c_str());
+    ASSERT_STREQ("kilogram*meter/second^2", newton.getName().c_str());
+
+    Unit kilonewton = 1000.0 * newton;
+    std::stringstream stream;
+    stream << kilonewton;
+
+    ASSERT_STREQ("1000*kg*m/s^2", stream.str().c_str());
+    ASSERT_STREQ("(Kelvin+10)", (kelvin + 10.0).getName().c_str());
+    ASSERT_STREQ("2/s", (2.0 / second).getSymbol().c_str());
+
+    Unit renamed = newton;
+    renamed.setSymbol("N");
+
+    ASSERT_STREQ("N", renamed.getSymbol().c_str());
+    ASSERT_STREQ("kilogram*meter/second^2", renamed.getName().c_str());
+    ASSERT_STREQ("", Unit().getName().c_str());
+}
+
 TEST_F(UnitTest, Add)
 {
     Unit expected1 = Unit("degree Celsius", "°C", Dimensions(0, 0, 0, 0, 1), 1.0, 273.15);
@@ -154,9 +179,119 @@ TEST_F(UnitTest, Add)
 TEST_F(UnitTest, Subtract)
 {
     Unit expected1 = Unit("Kelvin", "K", Dimensions(0, 0, 0, 0, 1));
-    Unit result1 = celsius - 273.15;
+    Unit result1 = celsius + 273.15;
 
     ASSERT_TRUE(expected1.equals(result1));
+
+    Unit expected2 = Unit("degree Celsius", "°C", Dimensions(0, 0, 0, 0, 1), 1.0, -546.3);
+    Unit result2 = celsius - 273.15;
+
+    ASSERT_TRUE(expected2.equals(result2));
+    ASSERT_FALSE(kelvin.equals(result2));
+}
+
+TEST_F(UnitTest, TryOperations)
+{
+    Unit result = meter;
+
+    ASSERT_EQ(OperationStatus::UnsupportedOperation, celsius.tryPower(2, result));
+    ASSERT_EQ(OperationStatus::UnsupportedOperation, meter.tryMultiplyBy(celsius, result));
+    ASSERT_EQ(OperationStatus::UnsupportedOperation, celsius.tryDivideBy(second, result));
+    ASSERT_EQ(OperationStatus::DimensionsOverflow, meter.tryPower(200, result));
+    ASSERT_EQ(OperationStatus::DimensionsOverflow, meter.power(100).tryMultiplyBy(meter.power(100), result));
+    ASSERT_EQ(OperationStatus::DimensionsOverflow, meter.power(-100).tryDivideBy(meter.power(100), result));
+    ASSERT_TRUE(result == meter);
+
+    ASSERT_EQ(OperationStatus::Ok, meter.tryPower(3, result));
+    ASSERT_TRUE(result == Unit("cubic meter", "m^3", Dimensions(3)));
+    ASSERT_EQ(OperationStatus::Ok, kilogram.tryMultiplyBy(meter, result));
+    ASSERT_STREQ("kg*m", result.getSymbol().c_str());
+    ASSERT_EQ(OperationStatus::Ok, meter.tryDivideBy(second, result));
+    ASSERT_STREQ("m/s", result.getSymbol().c_str());
+}
+
+TEST_F(UnitTest, Identity)
+{
+    Unit squareMeter = Unit("Square meter", "m^2", Dimensions(2));
+
+    ASSERT_EQ(squareMeter.getId(), (meter * meter).getId());
+    ASSERT_EQ(squareMeter.getId(), meter.power(2).getId());
+    ASSERT_EQ(std::hash<Unit>()(squareMeter), std::hash<Unit>()(meter * meter));
+    ASSERT_NE(meter.getId(), feet.getId());
+    ASSERT_NE(kelvin.getId(), celsius.getId());
+
+    Unit inch = Unit("inch", "in", Dimensions(1), 0.0254);
+    Unit inchFromThou = 1000.0 * Unit("thou", "th", Dimensions(1), 0.0000254);
+
+    ASSERT_TRUE(inch == inchFromThou);
+    ASSERT_TRUE((inch * inch) / inch == inchFromThou);
+
+    Unit renamed = feet;
+    renamed.setFactor(1.0);
+
+    ASSERT_TRUE(renamed == meter);
+}
+
+TEST_F(UnitTest, IdentityIsTransitive)
+{
+    // factors a few 1e-13 apart, created out of order: equality must not
+    // depend on which unit was interned first
+    std::vector<Unit> units;
+    for(int i : {5, 0, 10, 3, 8, 1, 6, 9, 2, 7, 4})
+        units.push_back(Unit("", "", Dimensions(0, 0, 0, 0, 0, 0, 3), 1.0 + i * 3e-13));
+
+    for(const Unit &a : units)
+        for(const Unit &b : units)
+            for(const Unit &c : units)
+                ASSERT_FALSE(a == b && b == c && a != c);
+
+    ASSERT_TRUE(Unit("", "", Dimensions(0, 0, 0, 0, 0, 0, 3), 1.0 + 1e-15) == Unit("", "", Dimensions(0, 0, 0, 0, 0, 0, 3), 1.0));
+}
+TEST_F(UnitTest, SharedBody)
+{
+    static_assert(sizeof(Unit) == sizeof(void*), "Unit must only reference its shared body");
+
+    Unit copy = feet;
+
+    ASSERT_EQ(&feet.getName(), &copy.getName());
+    ASSERT_EQ(&feet.getSymbol(), &copy.getSymbol());
+    ASSERT_EQ(&feet.getDimensions(), &copy.getDimensions());
+
+    Unit moved = std::move(copy);
+
+    ASSERT_EQ(&feet.getSymbol(), &moved.getSymbol());
+
+    moved.setSymbol("FT");
+    moved.setFactor(0.3);
+
+    ASSERT_STREQ("ft", feet.getSymbol().c_str());
+    ASSERT_DOUBLE_EQ(0.3048, feet.getFactor());
+    ASSERT_STREQ("FT", moved.getSymbol().c_str());
+    ASSERT_STREQ("feet", moved.getName().c_str());
+    ASSERT_DOUBLE_EQ(0.3, moved.getFactor());
+    ASSERT_TRUE(Unit() == Unit("", "", Dimensions()));
+    ASSERT_TRUE(Unit().getSymbol().empty());
+}
+TEST_F(UnitTest, ExactFactor)
+{
+    ASSERT_EQ(Rational(3048, 1, -4), feet.getExactFactor());
+    ASSERT_EQ(Rational(1), meter.getExactFactor());
+    ASSERT_EQ(Rational(3048 * 3048, 1, -8), (feet * feet).getExactFactor());
+    ASSERT_EQ(Rational(1, 3048, 4), (meter / feet).getExactFactor());
+    ASSERT_EQ(Rational(3048, 1, -1), (1000.0 * feet).getExactFactor());
+    ASSERT_EQ(feet.getExactFactor(), (feet + 5.0).getExactFactor());
+
+    Unit third("third", "t", Dimensions(), Rational(1, 3));
+    ASSERT_DOUBLE_EQ(1.0 / 3.0, third.getFactor());
+    ASSERT_EQ(Rational(1, 9), third.power(2).getExactFactor());
+    ASSERT_EQ(Rational(1, 3), Unit("copy", "c", third).getExactFactor());
+
+    Unit inexact("inexact", "i", Dimensions(1), 1.0 / 7.0);
+    ASSERT_FALSE(inexact.getExactFactor().isValid());
+    ASSERT_FALSE((inexact * meter).getExactFactor().isValid());
+
+    inexact.setFactor(0.5);
+    ASSERT_EQ(Rational(5, 1, -1), inexact.getExactFactor());
 }
 
 }